@@ -21,8 +21,21 @@ static int driver_api_set_setpoint(const struct device *dev,
 {
 	const struct driver_config *dev_config = dev->config;
 	uint8_t data[sizeof(q31_t)];
+	int ret;
 
 	sys_put_le32(setpoint, &data[0]);
+
+	/* Avoid waiting for the bus transport from the control loop if possible */
+	ret = zvb_bus_transmit_async(dev_config->bus,
+				     dev_config->addr,
+				     data,
+				     sizeof(data),
+				     NULL,
+				     NULL);
+	if (ret != -ENOSYS) {
+		return ret;
+	}
+
 	return zvb_bus_transmit(dev_config->bus, dev_config->addr, data, sizeof(data));
 }
 
@@ -10,6 +10,13 @@
 
 #define DT_DRV_COMPAT zvb_button
 
+/*
+ * Reports may block on the input queue, so they are made from the deferred
+ * dispatch of the bus if available, and never block the bus receive thread.
+ */
+#define DRIVER_DISPATCH \
+	(IS_ENABLED(CONFIG_ZVB_BUS_ZVB_DEFERRED) ? ZVB_BUS_DISPATCH_DEFERRED : ZVB_BUS_DISPATCH_INLINE)
+
 struct driver_data {
 	const struct device *dev;
 	struct zvb_bus_receive_callback callback;
@@ -29,7 +36,11 @@ static void driver_receive_handler(const struct device *bus,
 	const struct device *dev = dev_data->dev;
 	const struct driver_config *dev_config = dev->config;
 
-	input_report_key(dev, dev_config->code, data[0], true, K_FOREVER);
+	input_report_key(dev,
+			 dev_config->code,
+			 data[0],
+			 true,
+			 DRIVER_DISPATCH == ZVB_BUS_DISPATCH_DEFERRED ? K_FOREVER : K_NO_WAIT);
 }
 
 static int driver_init(const struct device *dev)
@@ -48,7 +59,11 @@ static int driver_init(const struct device *dev)
 												\
 	static struct driver_data data##inst = {						\
 		.dev = DEVICE_DT_INST_GET(inst),						\
-		.callback = ZVB_BUS_DT_INST_RECEIVE_CALLBACK_INIT(inst, driver_receive_handler),\
+		.callback = ZVB_BUS_DT_INST_RECEIVE_CALLBACK_INIT_DISPATCH(			\
+			inst,									\
+			driver_receive_handler,							\
+			DRIVER_DISPATCH								\
+		),										\
 	};											\
 												\
 	static struct driver_config config##inst = {						\
@@ -9,6 +9,11 @@
 #include <zephyr/kernel.h>
 #include <zephyr/sys/byteorder.h>
 #include <zvb/drivers/zvb_bus.h>
+#include <string.h>
+
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_DELTA
+#include "sensor_zvb_sensor_delta.h"
+#endif
 
 #define DT_DRV_COMPAT zvb_sensor
 
@@ -19,14 +24,55 @@ __packed struct driver_transmit_data {
 	uint32_t channel_index;
 };
 
+__packed struct driver_buffer_data_frame {
+	uint32_t channel_type;
+	uint32_t channel_index;
+	uint32_t shift;
+	q31_t readings[3];
+};
+
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_FLAGS
+/*
+ * Requests end with [flags], followed by [generation of the last decoded reply]
+ * if flagged DRIVER_REQUEST_FLAG_DELTA, and by [request id] if flagged
+ * DRIVER_REQUEST_FLAG_ID. Replies to them start with [flags], followed by the
+ * echoed [request id] if flagged DRIVER_REPLY_FLAG_ID, by
+ * [generation][base generation] if delta encoded, and by the host time the
+ * readings were sampled at if flagged DRIVER_REPLY_FLAG_TIMESTAMP.
+ */
+#define DRIVER_REQUEST_FLAG_DELTA BIT(0)
+#define DRIVER_REQUEST_FLAG_ID BIT(1)
+#define DRIVER_REQUEST_TRAILER_SIZE_MAX 3
+#define DRIVER_REPLY_FLAG_TIMESTAMP BIT(0)
+#define DRIVER_REPLY_FLAG_DELTA BIT(1)
+#define DRIVER_REPLY_FLAG_ID BIT(2)
+#endif
+
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_DELTA
+#define DRIVER_DELTA_HEADER_SIZE 2
+#endif
+
 struct driver_data {
 	struct zvb_bus_receive_callback callback;
 	const struct device *const dev;
 	struct mpsc iodev_sqe_q;
 	struct rtio_iodev_sqe *txn_head;
 	struct rtio_iodev_sqe *txn_curr;
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_RETRY
+	uint8_t txn_retries;
+	/* Id of the last submitted request, only its reply is accepted */
+	uint8_t tx_id;
+	struct k_work_delayable timeout_dwork;
+#endif
 	struct k_sem lock;
 	struct driver_transmit_data tx_data[CONFIG_SENSOR_ZVB_SENSOR_MAX_CHANNELS];
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_DELTA
+	uint16_t tx_count;
+	/* Generation of the last decoded reply, 0 if none */
+	uint8_t delta_gen;
+	uint32_t delta_fields[CONFIG_SENSOR_ZVB_SENSOR_MAX_CHANNELS]
+			    [SENSOR_ZVB_SENSOR_DELTA_FIELD_COUNT];
+#endif
 };
 
 struct driver_config {
@@ -39,18 +85,21 @@ __packed struct driver_buffer_data_header {
 	uint32_t frame_count;
 };
 
-__packed struct driver_buffer_data_frame {
-	uint32_t channel_type;
-	uint32_t channel_index;
-	uint32_t shift;
-	q31_t readings[3];
-};
+/* Replies may carry the host time the readings were sampled at */
+#define DRIVER_RECEIVE_TIMESTAMP_SIZE sizeof(uint64_t)
 
 __packed struct driver_buffer_data {
 	struct driver_buffer_data_header header;
 	struct driver_buffer_data_frame frames[];
 };
 
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_RETRY
+/* Requests of all sensor instances are resubmitted by a single work queue */
+static K_THREAD_STACK_DEFINE(retry_workq_stack, CONFIG_SENSOR_ZVB_SENSOR_RETRY_THREAD_STACK_SIZE);
+static struct k_work_q retry_workq;
+static bool retry_started;
+#endif
+
 static void driver_lock(const struct device *dev)
 {
 	struct driver_data *dev_data = dev->data;
@@ -65,6 +114,32 @@ static void driver_unlock(const struct device *dev)
 	k_sem_give(&dev_data->lock);
 }
 
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_FLAGS
+/* Fill trailer of request, returns its size */
+static size_t driver_request_trailer(const struct device *dev, uint8_t *trailer)
+{
+	struct driver_data *dev_data = dev->data;
+	size_t size = sizeof(uint8_t);
+
+	trailer[0] = 0;
+
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_DELTA
+	/* Requests a reply encoded against the last decoded reply */
+	trailer[0] |= DRIVER_REQUEST_FLAG_DELTA;
+	trailer[size++] = dev_data->delta_gen;
+#endif
+
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_RETRY
+	/* Every submission gets a new id, so replies to earlier ones are told apart */
+	dev_data->tx_id++;
+	trailer[0] |= DRIVER_REQUEST_FLAG_ID;
+	trailer[size++] = dev_data->tx_id;
+#endif
+
+	return size;
+}
+#endif
+
 static void driver_txn_start_locked(const struct device *dev)
 {
 	struct driver_data *dev_data = dev->data;
@@ -73,6 +148,10 @@ static void driver_txn_start_locked(const struct device *dev)
 	const struct sensor_read_config *read_config = iodev_sqe->sqe.iodev->data;
 	uint16_t count;
 	size_t tx_data_size;
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_FLAGS
+	uint8_t trailer[DRIVER_REQUEST_TRAILER_SIZE_MAX];
+	struct zvb_bus_iovec iov[2];
+#endif
 
 	if (ARRAY_SIZE(dev_data->tx_data) < read_config->count) {
 		count = ARRAY_SIZE(dev_data->tx_data);
@@ -88,10 +167,29 @@ static void driver_txn_start_locked(const struct device *dev)
 		tx_data_size += sizeof(struct driver_transmit_data);
 	}
 
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_DELTA
+	dev_data->tx_count = count;
+#endif
+
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_FLAGS
+	iov[0].data = (const uint8_t *)dev_data->tx_data;
+	iov[0].size = tx_data_size;
+	iov[1].data = trailer;
+	iov[1].size = driver_request_trailer(dev, trailer);
+
+	zvb_bus_transmit_iov(dev_config->bus, dev_config->addr, iov, ARRAY_SIZE(iov));
+#else
 	zvb_bus_transmit(dev_config->bus,
 			 dev_config->addr,
 			 (const uint8_t *)dev_data->tx_data,
 			 tx_data_size);
+#endif
+
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_RETRY
+	k_work_reschedule_for_queue(&retry_workq,
+				    &dev_data->timeout_dwork,
+				    K_MSEC(CONFIG_SENSOR_ZVB_SENSOR_TIMEOUT_MS));
+#endif
 }
 
 static void driver_sqe_next_locked(const struct device *dev)
@@ -102,9 +200,15 @@ static void driver_sqe_next_locked(const struct device *dev)
 
 	dev_data->txn_head = NULL;
 	dev_data->txn_curr = NULL;
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_RETRY
+	dev_data->txn_retries = 0;
+#endif
 
 	node = mpsc_pop(&dev_data->iodev_sqe_q);
 	if (node == NULL) {
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_RETRY
+		k_work_cancel_delayable(&dev_data->timeout_dwork);
+#endif
 		return;
 	}
 
@@ -135,6 +239,9 @@ static void driver_txn_next_locked(const struct device *dev,
 	struct driver_data *dev_data = dev->data;
 
 	dev_data->txn_curr = rtio_txn_next(dev_data->txn_curr);
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_RETRY
+	dev_data->txn_retries = 0;
+#endif
 	if (dev_data->txn_curr != NULL) {
 		driver_txn_start_locked(dev);
 		return;
@@ -146,6 +253,134 @@ static void driver_txn_next_locked(const struct device *dev,
 	driver_sqe_next_locked(dev);
 }
 
+/* Keep the receive time if the host clock is not yet known */
+static void driver_map_host_time(const struct device *dev,
+				 uint64_t host_time_us,
+				 uint64_t *timestamp_ns)
+{
+	const struct driver_config *dev_config = dev->config;
+	int64_t uptime_ns;
+
+	if (zvb_bus_host_time_to_uptime(dev_config->bus, host_time_us, &uptime_ns)) {
+		return;
+	}
+
+	*timestamp_ns = (uint64_t)MAX(uptime_ns, 0);
+}
+
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_DELTA
+/*
+ * Each frame is a mask of changed fields followed by the varint delta of each
+ * changed field against the same frame of the base reply. A base generation of
+ * 0 encodes against zeroed frames.
+ */
+static int driver_delta_decode_locked(const struct device *dev,
+				      uint8_t flags,
+				      const uint8_t *data,
+				      size_t size,
+				      uint64_t *base_timestamp_ns)
+{
+	struct driver_data *dev_data = dev->data;
+	const uint8_t *end = data + size;
+	uint8_t gen;
+	uint8_t base_gen;
+
+	if (size < DRIVER_DELTA_HEADER_SIZE) {
+		return -EINVAL;
+	}
+
+	gen = data[0];
+	base_gen = data[1];
+	data += DRIVER_DELTA_HEADER_SIZE;
+
+	if (gen == 0) {
+		return -EINVAL;
+	}
+
+	if (base_gen == 0) {
+		memset(dev_data->delta_fields, 0, sizeof(dev_data->delta_fields));
+	} else if (base_gen != dev_data->delta_gen) {
+		/* Encoded against a reply which was lost or has been superseded */
+		return -EINVAL;
+	}
+
+	if (flags & DRIVER_REPLY_FLAG_TIMESTAMP) {
+		if ((size_t)(end - data) < DRIVER_RECEIVE_TIMESTAMP_SIZE) {
+			return -EINVAL;
+		}
+
+		driver_map_host_time(dev, sys_get_le64(data), base_timestamp_ns);
+		data += DRIVER_RECEIVE_TIMESTAMP_SIZE;
+	}
+
+	if (sensor_zvb_sensor_delta_apply(dev_data->delta_fields, dev_data->tx_count, &data, end)) {
+		return -EINVAL;
+	}
+
+	if (data != end) {
+		return -EINVAL;
+	}
+
+	/* The host encodes frames beyond those of the base reply against zero */
+	memset(&dev_data->delta_fields[dev_data->tx_count],
+	       0,
+	       sizeof(dev_data->delta_fields[0]) *
+	       (ARRAY_SIZE(dev_data->delta_fields) - dev_data->tx_count));
+
+	dev_data->delta_gen = gen;
+	return 0;
+}
+
+static void driver_txn_receive_delta_locked(const struct device *dev,
+					    uint8_t flags,
+					    const uint8_t *data,
+					    size_t size,
+					    uint64_t base_timestamp_ns,
+					    struct rtio_iodev_sqe **iodev_sqe,
+					    int *result)
+{
+	struct driver_data *dev_data = dev->data;
+	uint8_t *rx_buf;
+	uint32_t rx_buf_len;
+	struct driver_buffer_data *buf_data;
+	struct driver_buffer_data_frame *frame_it;
+	const uint32_t *fields;
+
+	if (dev_data->tx_count == 0 ||
+	    driver_delta_decode_locked(dev, flags, data, size, &base_timestamp_ns)) {
+		/* Request the next reply encoded against zeroed frames */
+		dev_data->delta_gen = 0;
+		driver_sqe_cancel_locked(dev, iodev_sqe, result);
+		return;
+	}
+
+	size = dev_data->tx_count * sizeof(struct driver_buffer_data_frame);
+
+	if (rtio_sqe_rx_buf(dev_data->txn_curr, size, size, &rx_buf, &rx_buf_len)) {
+		driver_sqe_cancel_locked(dev, iodev_sqe, result);
+		return;
+	}
+
+	buf_data = (struct driver_buffer_data *)rx_buf;
+	buf_data->header.base_timestamp_ns = base_timestamp_ns;
+	buf_data->header.frame_count = dev_data->tx_count;
+
+	frame_it = buf_data->frames;
+	for (uint16_t i = 0; i < dev_data->tx_count; i++) {
+		fields = dev_data->delta_fields[i];
+		frame_it->channel_type = fields[0];
+		frame_it->channel_index = fields[1];
+		frame_it->shift = fields[2];
+		frame_it->readings[0] = (q31_t)fields[3];
+		frame_it->readings[1] = (q31_t)fields[4];
+		frame_it->readings[2] = (q31_t)fields[5];
+		frame_it++;
+	}
+
+	driver_txn_next_locked(dev, iodev_sqe, result);
+}
+#endif
+
 static void driver_txn_receive_locked(const struct device *dev,
 				      const uint8_t *data,
 				      size_t size,
@@ -159,17 +394,68 @@ static void driver_txn_receive_locked(const struct device *dev,
 	struct driver_buffer_data *buf_data;
 	const uint8_t *data_it;
 	struct driver_buffer_data_frame *frame_it;
+	bool timestamped;
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_FLAGS
+	uint8_t flags;
+#endif
 
 	if (dev_data->txn_head == NULL) {
 		return;
 	}
 
-	if (size == 0 || (size % sizeof(struct driver_buffer_data_frame))) {
+	base_timestamp_ns = k_ticks_to_ns_floor64(k_uptime_ticks());
+
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_FLAGS
+	if (size == 0) {
 		driver_sqe_cancel_locked(dev, iodev_sqe, result);
 		return;
 	}
 
-	base_timestamp_ns = k_ticks_to_ns_floor64(k_uptime_ticks());
+	flags = data[0];
+	data++;
+	size--;
+
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_RETRY
+	/* Replies to earlier submissions of the request arrived late, and are dropped */
+	if (!(flags & DRIVER_REPLY_FLAG_ID) || size == 0 || data[0] != dev_data->tx_id) {
+		LOG_DBG("Dropped stale reply");
+		return;
+	}
+
+	data++;
+	size--;
+#endif
+
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_DELTA
+	if (flags & DRIVER_REPLY_FLAG_DELTA) {
+		driver_txn_receive_delta_locked(dev, flags, data, size, base_timestamp_ns,
+						iodev_sqe, result);
+		return;
+	}
+#endif
+
+	timestamped = flags & DRIVER_REPLY_FLAG_TIMESTAMP;
+#else
+	/* Unflagged replies are whole frames, optionally prefixed with the host time */
+	timestamped = (size % sizeof(struct driver_buffer_data_frame)) ==
+		      DRIVER_RECEIVE_TIMESTAMP_SIZE;
+#endif
+
+	if (timestamped) {
+		if (size < DRIVER_RECEIVE_TIMESTAMP_SIZE) {
+			driver_sqe_cancel_locked(dev, iodev_sqe, result);
+			return;
+		}
+
+		driver_map_host_time(dev, sys_get_le64(data), &base_timestamp_ns);
+		data += DRIVER_RECEIVE_TIMESTAMP_SIZE;
+		size -= DRIVER_RECEIVE_TIMESTAMP_SIZE;
+	}
+
+	if (size == 0 || (size % sizeof(struct driver_buffer_data_frame))) {
+		driver_sqe_cancel_locked(dev, iodev_sqe, result);
+		return;
+	}
 
 	if (rtio_sqe_rx_buf(dev_data->txn_curr, size, size, &rx_buf, &rx_buf_len)) {
 		driver_sqe_cancel_locked(dev, iodev_sqe, result);
@@ -202,6 +488,19 @@ static void driver_txn_receive_locked(const struct device *dev,
 	driver_txn_next_locked(dev, iodev_sqe, result);
 }
 
+static void driver_sqe_complete(struct rtio_iodev_sqe *iodev_sqe, int result)
+{
+	if (iodev_sqe == NULL) {
+		return;
+	}
+
+	if (result < 0) {
+		rtio_iodev_sqe_err(iodev_sqe, result);
+	} else {
+		rtio_iodev_sqe_ok(iodev_sqe, result);
+	}
+}
+
 static void driver_receive_handler(const struct device *bus,
 				   const struct zvb_bus_receive_callback *callback,
 				   const uint8_t *data,
@@ -216,16 +515,80 @@ static void driver_receive_handler(const struct device *bus,
 	driver_txn_receive_locked(dev, data, size, &iodev_sqe, &result);
 	driver_unlock(dev);
 
-	if (iodev_sqe == NULL) {
+	driver_sqe_complete(iodev_sqe, result);
+}
+
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_RETRY
+/* Resubmit request of current transaction, assuming it or its reply was lost */
+static void driver_txn_retry_locked(const struct device *dev,
+				    struct rtio_iodev_sqe **iodev_sqe,
+				    int *result)
+{
+	struct driver_data *dev_data = dev->data;
+
+	if (dev_data->txn_head == NULL) {
 		return;
 	}
 
-	if (result < 0) {
-		rtio_iodev_sqe_err(iodev_sqe, result);
-	} else {
-		rtio_iodev_sqe_ok(iodev_sqe, result);
+	if (dev_data->txn_retries == CONFIG_SENSOR_ZVB_SENSOR_RETRIES) {
+		LOG_WRN("Request timed out");
+		*iodev_sqe = dev_data->txn_head;
+		*result = -ETIMEDOUT;
+		driver_sqe_next_locked(dev);
+		return;
 	}
+
+	dev_data->txn_retries++;
+	driver_txn_start_locked(dev);
+}
+
+static void driver_timeout_dwork_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct driver_data *dev_data = CONTAINER_OF(dwork, struct driver_data, timeout_dwork);
+	const struct device *dev = dev_data->dev;
+	struct rtio_iodev_sqe *iodev_sqe = NULL;
+	int result = 0;
+
+	driver_lock(dev);
+	driver_txn_retry_locked(dev, &iodev_sqe, &result);
+	driver_unlock(dev);
+
+	driver_sqe_complete(iodev_sqe, result);
+}
+
+static void driver_loss_handler(const struct device *bus,
+				const struct zvb_bus_receive_callback *callback,
+				uint32_t count)
+{
+	struct driver_data *dev_data = CONTAINER_OF(callback, struct driver_data, callback);
+
+	ARG_UNUSED(bus);
+	ARG_UNUSED(count);
+
+	/* The reply may have been lost, so retry now rather than on timeout */
+	k_work_reschedule_for_queue(&retry_workq, &dev_data->timeout_dwork, K_NO_WAIT);
+}
+
+static void driver_retry_start(void)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "zvb_sensor_retry",
+	};
+
+	if (retry_started) {
+		return;
+	}
+
+	k_work_queue_init(&retry_workq);
+	k_work_queue_start(&retry_workq,
+			   retry_workq_stack,
+			   K_THREAD_STACK_SIZEOF(retry_workq_stack),
+			   CONFIG_SENSOR_ZVB_SENSOR_RETRY_THREAD_PRIORITY,
+			   &cfg);
+	retry_started = true;
 }
+#endif /* CONFIG_SENSOR_ZVB_SENSOR_RETRY */
 
 static void driver_submit_locked(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
 {
@@ -391,6 +754,11 @@ static int driver_init(const struct device *dev)
 
 	mpsc_init(&dev_data->iodev_sqe_q);
 	k_sem_init(&dev_data->lock, 1, 1);
+#ifdef CONFIG_SENSOR_ZVB_SENSOR_RETRY
+	driver_retry_start();
+	k_work_init_delayable(&dev_data->timeout_dwork, driver_timeout_dwork_handler);
+	zvb_bus_receive_callback_set_loss_handler(&dev_data->callback, driver_loss_handler);
+#endif
 
 	return zvb_bus_add_receive_callback(dev_config->bus, &dev_data->callback);
 }
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "sensor_zvb_sensor_delta.h"
+
+int sensor_zvb_sensor_delta_get_varint(const uint8_t **data,
+				       const uint8_t *end,
+				       uint32_t *value)
+{
+	uint32_t raw = 0;
+
+	for (uint8_t shift = 0; shift < 35; shift += 7) {
+		if (*data == end) {
+			return -EINVAL;
+		}
+
+		raw |= (uint32_t)(**data & 0x7F) << shift;
+		if ((*(*data)++ & 0x80) == 0) {
+			*value = (raw >> 1) ^ (0 - (raw & 1));
+			return 0;
+		}
+	}
+
+	return -EINVAL;
+}
+
+int sensor_zvb_sensor_delta_apply(uint32_t (*fields)[SENSOR_ZVB_SENSOR_DELTA_FIELD_COUNT],
+				  size_t count,
+				  const uint8_t **data,
+				  const uint8_t *end)
+{
+	uint8_t mask;
+	uint32_t delta;
+
+	for (size_t i = 0; i < count; i++) {
+		if (*data == end) {
+			return -EINVAL;
+		}
+
+		mask = *(*data)++;
+		for (uint8_t j = 0; j < SENSOR_ZVB_SENSOR_DELTA_FIELD_COUNT; j++) {
+			if ((mask & BIT(j)) == 0) {
+				continue;
+			}
+
+			if (sensor_zvb_sensor_delta_get_varint(data, end, &delta)) {
+				return -EINVAL;
+			}
+
+			fields[i][j] += delta;
+		}
+	}
+
+	return 0;
+}
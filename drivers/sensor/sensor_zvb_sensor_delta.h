@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_DRIVERS_SENSOR_SENSOR_ZVB_SENSOR_DELTA_H_
+#define ZEPHYR_DRIVERS_SENSOR_SENSOR_ZVB_SENSOR_DELTA_H_
+
+#include <zephyr/kernel.h>
+
+/* Fields of a frame, in order, which are delta encoded */
+#define SENSOR_ZVB_SENSOR_DELTA_FIELD_COUNT 6
+
+/* Get zigzag encoded LEB128 varint, returns -EINVAL if truncated or too long */
+int sensor_zvb_sensor_delta_get_varint(const uint8_t **data,
+				       const uint8_t *end,
+				       uint32_t *value);
+
+/*
+ * Add the deltas of count encoded frames to fields. Returns -EINVAL if the
+ * frames are truncated, in which case fields are partially updated.
+ */
+int sensor_zvb_sensor_delta_apply(uint32_t (*fields)[SENSOR_ZVB_SENSOR_DELTA_FIELD_COUNT],
+				  size_t count,
+				  const uint8_t **data,
+				  const uint8_t *end);
+
+#endif /* ZEPHYR_DRIVERS_SENSOR_SENSOR_ZVB_SENSOR_DELTA_H_ */
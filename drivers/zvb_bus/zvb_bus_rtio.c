@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zvb/drivers/zvb_bus.h>
+#include <zephyr/rtio/rtio.h>
+
+static void zvb_bus_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct zvb_bus_dt_spec *dt_spec = iodev_sqe->sqe.iodev->data;
+	const struct zvb_bus_driver_api *api = DEVICE_API_GET(zvb_bus, dt_spec->dev);
+
+	if (api->iodev_submit == NULL) {
+		rtio_iodev_sqe_err(iodev_sqe, -ENOSYS);
+		return;
+	}
+
+	api->iodev_submit(dt_spec->dev, iodev_sqe);
+}
+
+const struct rtio_iodev_api zvb_bus_iodev_api = {
+	.submit = zvb_bus_iodev_submit,
+};
@@ -4,209 +4,2101 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
-#include <zephyr/net/socket.h>
 #include <zvb/drivers/zvb_bus.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/kernel.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/sys/barrier.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/mpsc_lockfree.h>
 #include <string.h>
-#include <poll.h>
+
+#include "zvb_bus_zvb_capture.h"
+#include "zvb_bus_zvb_clock.h"
+#include "zvb_bus_zvb_frame.h"
+#include "zvb_bus_zvb_stats.h"
+#include "zvb_bus_zvb_transport.h"
 
 #define DT_DRV_COMPAT zvb_zvb_bus
 
-LOG_MODULE_REGISTER(zvb_zvb_bus, CONFIG_ZVB_BUS_LOG_LEVEL);
+LOG_MODULE_REGISTER(zvb_zvb_bus, CONFIG_ZVB_BUS_LOG_LEVEL);
+
+#define DRIVER_TICK_ADDRESS 0xFD
+#define DRIVER_BATCH_ADDRESS 0xFE
+#define DRIVER_PING_ADDRESS 0xFF
+
+/*
+ * Messages are prefixed with [addr], followed by [priority] if
+ * ZVB_BUS_ZVB_PRIORITY is enabled.
+ */
+#ifdef CONFIG_ZVB_BUS_ZVB_PRIORITY
+#define DRIVER_MSG_HEADER_SIZE (sizeof(uint8_t) + sizeof(uint8_t))
+#define DRIVER_PRIORITY_COUNT 4
+#else
+#define DRIVER_MSG_HEADER_SIZE sizeof(uint8_t)
+#define DRIVER_PRIORITY_COUNT 1
+#endif
+
+#define DRIVER_BATCH_MSG_HEADER_SIZE (DRIVER_MSG_HEADER_SIZE + sizeof(uint16_t))
+
+/*
+ * If ZVB_BUS_ZVB_SEQ is enabled, datagrams are prefixed with [flags][seq (le16)].
+ * The SYNC flag is set by a sender which restarted its sequence, so the receiver
+ * accepts the sequence number without checking it.
+ */
+#define DRIVER_SEQ_HEADER_SIZE (sizeof(uint8_t) + sizeof(uint16_t))
+#define DRIVER_SEQ_FLAG_SYNC BIT(0)
+
+/* Only a single bus may gate simulated time */
+BUILD_ASSERT(!IS_ENABLED(CONFIG_ZVB_BUS_ZVB_LOCKSTEP) ||
+	     (DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) == 1),
+	     "Lockstep requires a single bus instance");
+
+#ifdef CONFIG_ZVB_BUS_ZVB_ASYNC_TX
+/* Message queued with zvb_bus_transmit_async() */
+struct driver_tx_msg {
+	sys_snode_t node;
+	zvb_bus_transmit_callback_t callback;
+	void *user_data;
+	uint16_t size;
+	uint8_t addr;
+	uint8_t data[CONFIG_ZVB_BUS_ZVB_ASYNC_TX_MSG_SIZE];
+};
+#endif
+
+#ifdef CONFIG_ZVB_BUS_ZVB_BATCH_STAGING
+/* Message staged for the next batch by zvb_bus_transmit() */
+struct driver_staged_msg {
+	struct mpsc_node node;
+	uint16_t size;
+	uint8_t addr;
+	uint8_t data[CONFIG_ZVB_BUS_ZVB_BATCH_STAGING_MSG_SIZE];
+};
+#endif
+
+struct driver_data {
+	const struct device *dev;
+	struct k_sem registry_sem;
+	struct k_sem ready_sem;
+	atomic_t ready;
+	/*
+	 * Receive callbacks indexed by device address. The lists are traversed
+	 * by the receive thread without locking, while writers serialize on
+	 * registry_sem. dispatch_seq is odd while the receive thread is
+	 * traversing a list, and threads which unlinked a callback wait on
+	 * dispatch_condvar for the traversal to end. The traversal follows
+	 * dispatch_next, so handlers may modify the list they are called from.
+	 */
+	sys_slist_t callbacks[UINT8_MAX + 1];
+	atomic_t dispatch_seq;
+	atomic_t dispatch_waiters;
+	struct k_mutex dispatch_mutex;
+	struct k_condvar dispatch_condvar;
+	sys_snode_t *dispatch_next;
+	k_tid_t receive_tid;
+	struct k_thread thread;
+	uint8_t receive_buf[CONFIG_ZVB_BUS_ZVB_TRANSFER_BUF_SIZE];
+#ifdef CONFIG_ZVB_BUS_ZVB_RX_POOL
+	/* Pooled buffer being handled by the receive thread, if any */
+	struct net_buf *rx_buf;
+#ifdef CONFIG_ZVB_BUS_ZVB_DEFERRED
+	/* Pooled buffer being handled by the deferred work queue, if any */
+	struct net_buf *deferred_buf;
+#endif
+#endif
+#ifdef CONFIG_ZVB_BUS_ZVB_DEFERRED
+	/* Handles the messages to deferred receive callbacks of the bus */
+	struct k_work_q deferred_workq;
+	struct k_work deferred_barrier_work;
+#endif
+	uint32_t tick;
+	/* Tick of the last ping sent */
+	uint32_t ping_tick;
+	uint32_t ping_cycles;
+	atomic_t ping_pending;
+#ifdef CONFIG_ZVB_BUS_ZVB_PING_PIGGYBACK
+	/* Uptime in ms from which the next message may carry a ping */
+	atomic_t ping_due;
+#endif
+#ifdef CONFIG_ZVB_BUS_ZVB_CLOCK_SYNC
+	int64_t ping_uptime_ns;
+	struct zvb_bus_zvb_clock clock;
+#endif
+	struct zvb_bus_zvb_transport transport;
+#ifdef CONFIG_ZVB_BUS_RTIO
+	/* RTIO reads awaiting a message, oldest first, linked through next */
+	struct k_spinlock rtio_lock;
+	struct rtio_iodev_sqe *rtio_rx_head;
+	struct rtio_iodev_sqe *rtio_rx_tail;
+#endif
+	struct k_work_delayable ping_dwork;
+	struct zvb_bus_zvb_stats_data stats;
+#ifdef CONFIG_ZVB_BUS_ZVB_CAPTURE
+	struct zvb_bus_zvb_capture capture;
+#endif
+#ifdef CONFIG_ZVB_BUS_ZVB_SEQ
+	/* Serializes sequence number assignment with sending */
+	struct k_sem tx_seq_sem;
+	uint16_t tx_seq;
+	bool tx_seq_synced;
+	/* Received sequence numbers, only accessed by the receive thread */
+	struct zvb_bus_zvb_seq rx_seq;
+#endif
+#ifdef CONFIG_ZVB_BUS_ZVB_LOCKSTEP
+	/* Simulated time granted by host, only accessed by the receive thread */
+	int64_t lockstep_grant_us;
+#endif
+#ifdef CONFIG_ZVB_BUS_ZVB_BATCH
+	struct k_sem transmit_sem;
+	uint8_t transmit_buf[CONFIG_ZVB_BUS_ZVB_TRANSFER_BUF_SIZE];
+	size_t transmit_buf_size;
+	struct k_work_delayable flush_dwork;
+#ifdef CONFIG_ZVB_BUS_ZVB_BATCH_STAGING
+	/*
+	 * Messages staged without taking transmit_sem, moved to transmit_buf by
+	 * its holder. staged_size is the batched size of the staged messages.
+	 */
+	struct mpsc staged_q;
+	atomic_t staged_size;
+	struct k_mem_slab staged_msg_slab;
+	struct driver_staged_msg staged_msg_buf[CONFIG_ZVB_BUS_ZVB_BATCH_STAGING_COUNT];
+#endif
+#endif
+#ifdef CONFIG_ZVB_BUS_ZVB_ASYNC_TX
+	/* Queued messages, indexed by priority */
+	struct k_spinlock tx_lock;
+	sys_slist_t tx_queues[DRIVER_PRIORITY_COUNT];
+	struct k_mem_slab tx_msg_slab;
+	struct k_work tx_work;
+	struct driver_tx_msg tx_msg_buf[CONFIG_ZVB_BUS_ZVB_ASYNC_TX_QUEUE_SIZE];
+#endif
+};
+
+struct driver_config {
+	struct zvb_bus_zvb_transport_config transport;
+	k_thread_stack_t *stack;
+	size_t stack_size;
+	int thread_priority;
+#ifdef CONFIG_ZVB_BUS_ZVB_DEFERRED
+	k_thread_stack_t *deferred_stack;
+	size_t deferred_stack_size;
+#endif
+#ifdef CONFIG_ZVB_BUS_ZVB_PRIORITY
+	/* Priority of messages to and from each address */
+	const uint8_t *priorities;
+#endif
+#ifdef CONFIG_ZVB_BUS_ZVB_RX_POOL
+	struct net_buf_pool *rx_pool;
+#endif
+#ifdef CONFIG_ZVB_BUS_ZVB_CAPTURE
+	const char *capture_file;
+#endif
+#ifdef CONFIG_ZVB_BUS_ZVB_STATS
+	STATS_SECT_DECL(zvb_bus_zvb_addr) *addr_stats;
+	const uint8_t *addr_stats_addrs;
+	const char *const *addr_stats_names;
+	size_t addr_stats_count;
+#endif
+};
+
+#ifdef CONFIG_ZVB_BUS_ZVB_DEFERRED
+/* Reference to pooled message, or copy of message, queued for a deferred receive handler */
+struct driver_deferred_msg {
+	struct k_work work;
+	const struct device *dev;
+	const struct zvb_bus_receive_callback *callback;
+	size_t size;
+#ifdef CONFIG_ZVB_BUS_ZVB_RX_POOL
+	struct net_buf *buf;
+	const uint8_t *data;
+#else
+	uint8_t data[CONFIG_ZVB_BUS_ZVB_TRANSFER_BUF_SIZE];
+#endif
+};
+
+/*
+ * Each bus instance handles its deferred messages with its own work queue,
+ * while the messages are allocated from a slab shared by all instances.
+ */
+K_MEM_SLAB_DEFINE_STATIC(deferred_msg_slab,
+			 sizeof(struct driver_deferred_msg),
+			 CONFIG_ZVB_BUS_ZVB_DEFERRED_MSG_COUNT,
+			 sizeof(void *));
+#endif
+
+#ifdef CONFIG_ZVB_BUS_ZVB_ASYNC_TX
+/* Asynchronous messages of all bus instances are transmitted by a single work queue */
+static K_THREAD_STACK_DEFINE(tx_workq_stack, CONFIG_ZVB_BUS_ZVB_ASYNC_TX_THREAD_STACK_SIZE);
+static struct k_work_q tx_workq;
+static bool tx_started;
+#endif
+
+static DEVICE_API(zvb_bus, driver_api);
+
+static uint8_t driver_priority(const struct driver_data *dev_data, uint8_t addr)
+{
+#ifdef CONFIG_ZVB_BUS_ZVB_PRIORITY
+	const struct driver_config *dev_config = dev_data->dev->config;
+
+	return dev_config->priorities[addr];
+#else
+	ARG_UNUSED(dev_data);
+	ARG_UNUSED(addr);
+	return 0;
+#endif
+}
+
+static void driver_msg_header_put(const struct driver_data *dev_data,
+				  uint8_t addr,
+				  uint8_t *header)
+{
+	header[0] = addr;
+#ifdef CONFIG_ZVB_BUS_ZVB_PRIORITY
+	header[1] = driver_priority(dev_data, addr);
+#else
+	ARG_UNUSED(dev_data);
+#endif
+}
+
+/*
+ * Send datagram made up of iov[1] to iov[iov_count - 1]. iov[0] is reserved
+ * for the sequence header.
+ */
+static int driver_transport_sendv(struct driver_data *dev_data,
+				  struct zvb_bus_iovec *iov,
+				  size_t iov_count)
+{
+	int ret;
+
+#ifdef CONFIG_ZVB_BUS_ZVB_SEQ
+	uint8_t header[DRIVER_SEQ_HEADER_SIZE];
+
+	k_sem_take(&dev_data->tx_seq_sem, K_FOREVER);
+
+	header[0] = dev_data->tx_seq_synced ? 0 : DRIVER_SEQ_FLAG_SYNC;
+	sys_put_le16(dev_data->tx_seq, &header[1]);
+	iov[0].data = header;
+	iov[0].size = sizeof(header);
+
+	ret = zvb_bus_zvb_transport_send(&dev_data->transport, iov, iov_count);
+	if (ret == 0) {
+		dev_data->tx_seq++;
+		dev_data->tx_seq_synced = true;
+	}
+
+	k_sem_give(&dev_data->tx_seq_sem);
+#else
+	iov++;
+	iov_count--;
+	ret = zvb_bus_zvb_transport_send(&dev_data->transport, iov, iov_count);
+#endif
+
+#ifdef CONFIG_ZVB_BUS_ZVB_CAPTURE
+	if (ret == 0) {
+		zvb_bus_zvb_capture_record(&dev_data->capture, ZVB_BUS_ZVB_CAPTURE_TX, iov, iov_count);
+	}
+#endif
+
+	return ret;
+}
+
+static inline int driver_transport_send(struct driver_data *dev_data,
+					const uint8_t *data,
+					size_t size)
+{
+	struct zvb_bus_iovec iov[2];
+
+	iov[1].data = data;
+	iov[1].size = size;
+
+	return driver_transport_sendv(dev_data, iov, ARRAY_SIZE(iov));
+}
+
+/* Start ping, returns the tick to send with it */
+static uint32_t driver_ping_start(struct driver_data *dev_data)
+{
+	uint32_t tick = dev_data->tick;
+
+	dev_data->ping_tick = tick;
+#ifdef CONFIG_ZVB_BUS_ZVB_CLOCK_SYNC
+	/* Pings are sent on tick boundaries, so the uptime is accurate */
+	dev_data->ping_uptime_ns = k_ticks_to_ns_floor64(k_uptime_ticks());
+#endif
+	dev_data->tick++;
+	dev_data->ping_cycles = k_cycle_get_32();
+	atomic_set(&dev_data->ping_pending, 1);
+	return tick;
+}
+
+#ifdef CONFIG_ZVB_BUS_ZVB_PING_PIGGYBACK
+/*
+ * Claim the due ping, unless an earlier ping still awaits its pong. The ping
+ * work is pushed back to an interval after the next ping is due, so it only
+ * runs once no message was transmitted for that long.
+ */
+static bool driver_ping_take(struct driver_data *dev_data)
+{
+	atomic_val_t due = atomic_get(&dev_data->ping_due);
+	uint32_t now = k_uptime_get_32();
+
+	if (atomic_get(&dev_data->ping_pending) || (int32_t)(now - (uint32_t)due) < 0) {
+		return false;
+	}
+
+	if (!atomic_cas(&dev_data->ping_due, due, now + CONFIG_ZVB_BUS_ZVB_PING_INTERVAL_MS)) {
+		return false;
+	}
+
+	k_work_reschedule(&dev_data->ping_dwork, K_MSEC(2 * CONFIG_ZVB_BUS_ZVB_PING_INTERVAL_MS));
+	return true;
+}
+
+/* Give back a claimed ping which could not be sent, so the next message carries it */
+static void driver_ping_untake(struct driver_data *dev_data)
+{
+	atomic_set(&dev_data->ping_pending, 0);
+	atomic_set(&dev_data->ping_due, k_uptime_get_32());
+}
+
+/*
+ * Send message in a batch with the due ping, so the pong returns with the
+ * response of the host. Returns 1 if no ping is due.
+ */
+static int driver_transport_send_iov_ping(struct driver_data *dev_data,
+					  uint8_t addr,
+					  const struct zvb_bus_iovec *iov,
+					  size_t iov_count)
+{
+	struct zvb_bus_iovec msg_iov[2 + CONFIG_ZVB_BUS_ZVB_TRANSMIT_IOV_MAX];
+	uint8_t prefix[sizeof(uint8_t) + DRIVER_BATCH_MSG_HEADER_SIZE + sizeof(uint32_t) +
+		       DRIVER_BATCH_MSG_HEADER_SIZE];
+	uint8_t *pos = prefix;
+	size_t size = 0;
+	int ret;
+
+	for (size_t i = 0; i < iov_count; i++) {
+		size += iov[i].size;
+	}
+
+	if (addr == DRIVER_PING_ADDRESS || size > UINT16_MAX || !driver_ping_take(dev_data)) {
+		return 1;
+	}
+
+	*pos = DRIVER_BATCH_ADDRESS;
+	pos += sizeof(uint8_t);
+	driver_msg_header_put(dev_data, DRIVER_PING_ADDRESS, pos);
+	pos += DRIVER_MSG_HEADER_SIZE;
+	sys_put_le16(sizeof(uint32_t), pos);
+	pos += sizeof(uint16_t);
+	sys_put_le32(driver_ping_start(dev_data), pos);
+	pos += sizeof(uint32_t);
+	driver_msg_header_put(dev_data, addr, pos);
+	pos += DRIVER_MSG_HEADER_SIZE;
+	sys_put_le16(size, pos);
+
+	msg_iov[1].data = prefix;
+	msg_iov[1].size = sizeof(prefix);
+
+	for (size_t i = 0; i < iov_count; i++) {
+		msg_iov[i + 2] = iov[i];
+	}
+
+	ret = driver_transport_sendv(dev_data, msg_iov, iov_count + 2);
+	if (ret < 0) {
+		driver_ping_untake(dev_data);
+	}
+
+	return ret;
+}
+#endif /* CONFIG_ZVB_BUS_ZVB_PING_PIGGYBACK */
+
+static inline int driver_transport_send_iov(struct driver_data *dev_data,
+					    uint8_t addr,
+					    const struct zvb_bus_iovec *iov,
+					    size_t iov_count)
+{
+	struct zvb_bus_iovec msg_iov[2 + CONFIG_ZVB_BUS_ZVB_TRANSMIT_IOV_MAX];
+	uint8_t header[DRIVER_MSG_HEADER_SIZE];
+
+#ifdef CONFIG_ZVB_BUS_ZVB_PING_PIGGYBACK
+	int ret = driver_transport_send_iov_ping(dev_data, addr, iov, iov_count);
+
+	if (ret <= 0) {
+		return ret;
+	}
+#endif
+
+	driver_msg_header_put(dev_data, addr, header);
+	msg_iov[1].data = header;
+	msg_iov[1].size = sizeof(header);
+
+	for (size_t i = 0; i < iov_count; i++) {
+		msg_iov[i + 2] = iov[i];
+	}
+
+	return driver_transport_sendv(dev_data, msg_iov, iov_count + 2);
+}
+
+static void driver_ping_send(struct driver_data *dev_data)
+{
+	uint8_t data[sizeof(uint32_t)];
+	const struct zvb_bus_iovec iov = {
+		.data = data,
+		.size = sizeof(data),
+	};
+
+	sys_put_le32(driver_ping_start(dev_data), data);
+	driver_transport_send_iov(dev_data, DRIVER_PING_ADDRESS, &iov, 1);
+}
+
+static void driver_ping_dwork_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct driver_data *dev_data = CONTAINER_OF(dwork, struct driver_data, ping_dwork);
+
+	driver_ping_send(dev_data);
+#ifdef CONFIG_ZVB_BUS_ZVB_PING_PIGGYBACK
+	/* No message carried a ping for an interval, so the next one may */
+	atomic_set(&dev_data->ping_due, k_uptime_get_32());
+#endif
+	k_work_schedule(dwork, K_MSEC(CONFIG_ZVB_BUS_ZVB_PING_INTERVAL_MS));
+}
+
+/* Wait for the receive thread to stop referencing unlinked callbacks */
+static void driver_registry_sync(struct driver_data *dev_data)
+{
+	atomic_val_t seq;
+
+	/* Handlers may remove callbacks from within the receive thread */
+	if (k_current_get() == dev_data->receive_tid) {
+		return;
+	}
+
+	k_mutex_lock(&dev_data->dispatch_mutex, K_FOREVER);
+
+	/* Pairs with driver_dispatch_end(), which checks for waiters after ending a traversal */
+	atomic_inc(&dev_data->dispatch_waiters);
+	seq = atomic_get(&dev_data->dispatch_seq);
+
+	while ((seq & 1) && (atomic_get(&dev_data->dispatch_seq) == seq)) {
+		k_condvar_wait(&dev_data->dispatch_condvar, &dev_data->dispatch_mutex, K_FOREVER);
+	}
+
+	atomic_dec(&dev_data->dispatch_waiters);
+	k_mutex_unlock(&dev_data->dispatch_mutex);
+}
+
+/* Start traversing callbacks from node, returns NULL at end of list */
+static struct zvb_bus_receive_callback *driver_dispatch_next(struct driver_data *dev_data,
+							     sys_snode_t *node)
+{
+	if (node == NULL) {
+		return NULL;
+	}
+
+	dev_data->dispatch_next = sys_slist_peek_next_no_check(node);
+	return CONTAINER_OF(node, struct zvb_bus_receive_callback, node);
+}
+
+static void driver_dispatch_begin(struct driver_data *dev_data)
+{
+	atomic_inc(&dev_data->dispatch_seq);
+}
+
+static void driver_dispatch_end(struct driver_data *dev_data)
+{
+	atomic_inc(&dev_data->dispatch_seq);
+
+	if (atomic_get(&dev_data->dispatch_waiters) == 0) {
+		return;
+	}
+
+	k_mutex_lock(&dev_data->dispatch_mutex, K_FOREVER);
+	k_condvar_broadcast(&dev_data->dispatch_condvar);
+	k_mutex_unlock(&dev_data->dispatch_mutex);
+}
+
+static bool driver_registry_remove_locked(struct driver_data *dev_data,
+					  sys_slist_t *list,
+					  sys_snode_t *node)
+{
+	sys_snode_t *prev;
+
+	if (!sys_slist_find(list, node, &prev)) {
+		return false;
+	}
+
+	/*
+	 * Unlink node without clearing its next pointer, which the receive
+	 * thread may be about to follow. The caller waits for the receive
+	 * thread to stop referencing it once registry_sem is released.
+	 */
+	if (prev == NULL) {
+		list->head = node->next;
+	} else {
+		prev->next = node->next;
+	}
+
+	if (list->tail == node) {
+		list->tail = prev;
+	}
+
+	/* A handler removed the callback its traversal was about to call */
+	if (k_current_get() == dev_data->receive_tid && dev_data->dispatch_next == node) {
+		dev_data->dispatch_next = node->next;
+	}
+
+	return true;
+}
+
+static void driver_call_handler(const struct device *dev,
+				const struct zvb_bus_receive_callback *callback,
+				const uint8_t *data,
+				size_t size)
+{
+#ifdef CONFIG_ZVB_BUS_ZVB_STATS
+	struct driver_data *dev_data = dev->data;
+	uint32_t start = k_cycle_get_32();
+
+	callback->handler(dev, callback, data, size);
+	zvb_bus_zvb_stats_record_handler(&dev_data->stats,
+					 callback->addr,
+					 k_cycle_get_32() - start);
+#else
+	callback->handler(dev, callback, data, size);
+#endif
+}
+
+#ifdef CONFIG_ZVB_BUS_ZVB_RX_POOL
+static bool driver_rx_buf_holds(const struct net_buf *buf, const uint8_t *data)
+{
+	return buf != NULL && data >= buf->__buf && data < (buf->__buf + buf->size);
+}
+#endif
+
+#ifdef CONFIG_ZVB_BUS_ZVB_DEFERRED
+static void driver_deferred_msg_handler(struct k_work *work)
+{
+	struct driver_deferred_msg *msg = CONTAINER_OF(work, struct driver_deferred_msg, work);
+#ifdef CONFIG_ZVB_BUS_ZVB_RX_POOL
+	struct driver_data *dev_data = msg->dev->data;
+
+	dev_data->deferred_buf = msg->buf;
+	driver_call_handler(msg->dev, msg->callback, msg->data, msg->size);
+	dev_data->deferred_buf = NULL;
+	net_buf_unref(msg->buf);
+#else
+	driver_call_handler(msg->dev, msg->callback, msg->data, msg->size);
+#endif
+	k_mem_slab_free(&deferred_msg_slab, msg);
+}
+
+static void driver_deferred_barrier_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+}
+
+static void driver_deferred_dispatch(struct driver_data *dev_data,
+				     const struct zvb_bus_receive_callback *callback,
+				     const uint8_t *data,
+				     size_t size)
+{
+	struct driver_deferred_msg *msg;
+
+#ifdef CONFIG_ZVB_BUS_ZVB_RX_POOL
+	/* Messages are queued by reference, so only pooled messages can be queued */
+	if (!driver_rx_buf_holds(dev_data->rx_buf, data)) {
+		LOG_WRN("Receive buffer pool empty, dropped message for addr: %u",
+			callback->addr);
+		ZVB_BUS_ZVB_ADDR_STATS_INC(&dev_data->stats, callback->addr, rx_drops);
+		return;
+	}
+#endif
+
+	/* The receive thread must never block on deferred handlers */
+	if (k_mem_slab_alloc(&deferred_msg_slab, (void **)&msg, K_NO_WAIT)) {
+		LOG_WRN("Deferred dispatch queue full, dropped message for addr: %u",
+			callback->addr);
+		ZVB_BUS_ZVB_ADDR_STATS_INC(&dev_data->stats, callback->addr, rx_drops);
+		return;
+	}
+
+	k_work_init(&msg->work, driver_deferred_msg_handler);
+	msg->dev = dev_data->dev;
+	msg->callback = callback;
+	msg->size = size;
+
+#ifdef CONFIG_ZVB_BUS_ZVB_RX_POOL
+	msg->buf = net_buf_ref(dev_data->rx_buf);
+	msg->data = data;
+#else
+	memcpy(msg->data, data, size);
+#endif
+	k_work_submit_to_queue(&dev_data->deferred_workq, &msg->work);
+}
+
+/* Wait for deferred messages queued before the call to be handled */
+static void driver_deferred_sync(struct driver_data *dev_data)
+{
+	struct k_work_sync sync;
+
+	if (k_current_get() == k_work_queue_thread_get(&dev_data->deferred_workq)) {
+		return;
+	}
+
+	k_work_submit_to_queue(&dev_data->deferred_workq, &dev_data->deferred_barrier_work);
+	k_work_flush(&dev_data->deferred_barrier_work, &sync);
+}
+
+static void driver_deferred_start(struct driver_data *dev_data,
+				  const struct driver_config *dev_config)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "zvb_bus_deferred",
+	};
+
+	k_work_init(&dev_data->deferred_barrier_work, driver_deferred_barrier_handler);
+	k_work_queue_init(&dev_data->deferred_workq);
+	k_work_queue_start(&dev_data->deferred_workq,
+			   dev_config->deferred_stack,
+			   dev_config->deferred_stack_size,
+			   CONFIG_ZVB_BUS_ZVB_DEFERRED_THREAD_PRIORITY,
+			   &cfg);
+}
+#endif /* CONFIG_ZVB_BUS_ZVB_DEFERRED */
+
+static void driver_registry_append_locked(sys_slist_t *list, sys_snode_t *node)
+{
+	/* Publish callback only once it is fully initialized */
+	barrier_dmem_fence_full();
+	sys_slist_append(list, node);
+}
+
+static int driver_api_add_receive_callback(const struct device *dev,
+					   struct zvb_bus_receive_callback *callback)
+{
+	struct driver_data *dev_data = dev->data;
+	sys_slist_t *list = &dev_data->callbacks[callback->addr];
+
+	if (callback->handler == NULL) {
+		return -EINVAL;
+	}
+
+	if (callback->dispatch == ZVB_BUS_DISPATCH_DEFERRED &&
+	    !IS_ENABLED(CONFIG_ZVB_BUS_ZVB_DEFERRED)) {
+		return -ENOTSUP;
+	}
+
+	/*
+	 * A callback which is already added is left in place, as relinking it
+	 * would cut short a traversal calling it from the receive thread.
+	 */
+	k_sem_take(&dev_data->registry_sem, K_FOREVER);
+	if (!sys_slist_find(list, &callback->node, NULL)) {
+		driver_registry_append_locked(list, &callback->node);
+	}
+	k_sem_give(&dev_data->registry_sem);
+
+	return 0;
+}
+
+static int driver_api_remove_receive_callback(const struct device *dev,
+					      struct zvb_bus_receive_callback *callback)
+{
+	struct driver_data *dev_data = dev->data;
+	sys_slist_t *list = &dev_data->callbacks[callback->addr];
+	bool removed;
+
+	k_sem_take(&dev_data->registry_sem, K_FOREVER);
+	removed = driver_registry_remove_locked(dev_data, list, &callback->node);
+	k_sem_give(&dev_data->registry_sem);
+
+	if (!removed) {
+		return 0;
+	}
+
+	/*
+	 * Handlers may themselves take registry_sem, so dispatches are waited
+	 * for only after the registry is released.
+	 */
+	driver_registry_sync(dev_data);
+
+	if (callback->dispatch == ZVB_BUS_DISPATCH_DEFERRED) {
+#ifdef CONFIG_ZVB_BUS_ZVB_DEFERRED
+		driver_deferred_sync(dev_data);
+#endif
+	}
+
+	return 0;
+}
+
+static void driver_wait_ready(struct driver_data *dev_data)
+{
+	if (atomic_get(&dev_data->ready)) {
+		return;
+	}
+
+	k_sem_take(&dev_data->ready_sem, K_FOREVER);
+	k_sem_give(&dev_data->ready_sem);
+}
+
+#ifdef CONFIG_ZVB_BUS_ZVB_BATCH
+/*
+ * Batched datagrams are prefixed with DRIVER_BATCH_ADDRESS, followed by
+ * any number of [header][size (le16)][data] sub-messages.
+ */
+static int driver_batch_flush_locked(struct driver_data *dev_data)
+{
+	int ret;
+
+	if (dev_data->transmit_buf_size == 0) {
+		return 0;
+	}
+
+	ret = driver_transport_send(dev_data, dev_data->transmit_buf, dev_data->transmit_buf_size);
+	dev_data->transmit_buf_size = 0;
+	k_work_cancel_delayable(&dev_data->flush_dwork);
+
+	/* Messages of the batch were accepted already, so the error is only counted */
+	if (ret < 0) {
+		zvb_bus_zvb_stats_record_tx_batch_error(&dev_data->stats);
+	}
+
+#ifdef CONFIG_ZVB_BUS_ZVB_BATCH_STAGING
+	/* Messages staged since the drain must not wait for the next transmit */
+	if (atomic_get(&dev_data->staged_size)) {
+		k_work_schedule(&dev_data->flush_dwork,
+				K_USEC(CONFIG_ZVB_BUS_ZVB_BATCH_FLUSH_DELAY_US));
+	}
+#endif
+
+	return ret;
+}
+
+#ifdef CONFIG_ZVB_BUS_ZVB_PRIORITY
+/* Batched messages are ordered by descending priority, so the host handles them first */
+static size_t driver_batch_insert_offset_locked(const struct driver_data *dev_data,
+						uint8_t priority)
+{
+	const uint8_t *buf = dev_data->transmit_buf;
+	size_t offset = sizeof(uint8_t);
+
+	while (offset < dev_data->transmit_buf_size && buf[offset + 1] >= priority) {
+		offset += DRIVER_BATCH_MSG_HEADER_SIZE +
+			  sys_get_le16(&buf[offset + DRIVER_MSG_HEADER_SIZE]);
+	}
+
+	return offset;
+}
+#endif
+
+static int driver_batch_append_locked(struct driver_data *dev_data,
+				      uint8_t addr,
+				      const struct zvb_bus_iovec *iov,
+				      size_t iov_count)
+{
+	uint8_t *buf = dev_data->transmit_buf;
+	int ret;
+	size_t size;
+	size_t msg_size;
+	size_t offset;
+
+	size = 0;
+	for (size_t i = 0; i < iov_count; i++) {
+		size += iov[i].size;
+	}
+
+	msg_size = DRIVER_BATCH_MSG_HEADER_SIZE + size;
+
+	if (sizeof(dev_data->transmit_buf) < (sizeof(uint8_t) + msg_size)) {
+		return -ENOMEM;
+	}
+
+	if (sizeof(dev_data->transmit_buf) < (dev_data->transmit_buf_size + msg_size)) {
+		ret = driver_batch_flush_locked(dev_data);
+		if (ret) {
+			return ret;
+		}
+	}
+
+	if (dev_data->transmit_buf_size == 0) {
+		buf[0] = DRIVER_BATCH_ADDRESS;
+		dev_data->transmit_buf_size = sizeof(uint8_t);
+		k_work_schedule(&dev_data->flush_dwork,
+				K_USEC(CONFIG_ZVB_BUS_ZVB_BATCH_FLUSH_DELAY_US));
+	}
+
+#ifdef CONFIG_ZVB_BUS_ZVB_PRIORITY
+	offset = driver_batch_insert_offset_locked(dev_data, driver_priority(dev_data, addr));
+	memmove(&buf[offset + msg_size], &buf[offset], dev_data->transmit_buf_size - offset);
+#else
+	offset = dev_data->transmit_buf_size;
+#endif
+
+	driver_msg_header_put(dev_data, addr, &buf[offset]);
+	sys_put_le16(size, &buf[offset + DRIVER_MSG_HEADER_SIZE]);
+	offset += DRIVER_BATCH_MSG_HEADER_SIZE;
+
+	for (size_t i = 0; i < iov_count; i++) {
+		memcpy(&buf[offset], iov[i].data, iov[i].size);
+		offset += iov[i].size;
+	}
+
+	dev_data->transmit_buf_size += msg_size;
+	return 0;
+}
+
+#ifdef CONFIG_ZVB_BUS_ZVB_PING_PIGGYBACK
+/* Add the due ping to the batch, so the pong returns with the response of the host */
+static void driver_batch_append_ping_locked(struct driver_data *dev_data)
+{
+	uint8_t data[sizeof(uint32_t)];
+	const struct zvb_bus_iovec iov = {
+		.data = data,
+		.size = sizeof(data),
+	};
+
+	if (!driver_ping_take(dev_data)) {
+		return;
+	}
+
+	sys_put_le32(driver_ping_start(dev_data), data);
+	if (driver_batch_append_locked(dev_data, DRIVER_PING_ADDRESS, &iov, 1)) {
+		driver_ping_untake(dev_data);
+	}
+}
+#endif
+
+#ifdef CONFIG_ZVB_BUS_ZVB_BATCH_STAGING
+/*
+ * Stage message for the next batch, without waiting for transmit_sem, so
+ * transmitting threads never wait for each other or for the transport. The
+ * flush work moves staged messages to the batch. Returns 1 if the message
+ * must be batched directly instead.
+ */
+static int driver_batch_stage(struct driver_data *dev_data,
+			      uint8_t addr,
+			      const struct zvb_bus_iovec *iov,
+			      size_t iov_count)
+{
+	struct driver_staged_msg *msg;
+	size_t size;
+	size_t msg_size;
+	uint8_t *pos;
+
+	size = 0;
+	for (size_t i = 0; i < iov_count; i++) {
+		size += iov[i].size;
+	}
+
+	if (size > sizeof(msg->data) ||
+	    k_mem_slab_alloc(&dev_data->staged_msg_slab, (void **)&msg, K_NO_WAIT)) {
+		return 1;
+	}
+
+	msg->size = size;
+	msg->addr = addr;
+
+	pos = msg->data;
+	for (size_t i = 0; i < iov_count; i++) {
+		memcpy(pos, iov[i].data, iov[i].size);
+		pos += iov[i].size;
+	}
+
+	mpsc_push(&dev_data->staged_q, &msg->node);
+
+	msg_size = DRIVER_BATCH_MSG_HEADER_SIZE + size;
+	if ((size_t)atomic_add(&dev_data->staged_size, msg_size) + msg_size <
+	    sizeof(dev_data->transmit_buf) - sizeof(uint8_t)) {
+		k_work_schedule(&dev_data->flush_dwork,
+				K_USEC(CONFIG_ZVB_BUS_ZVB_BATCH_FLUSH_DELAY_US));
+	} else {
+		/* A full batch is staged */
+		k_work_reschedule(&dev_data->flush_dwork, K_NO_WAIT);
+	}
+
+	return 0;
+}
+
+/* Move staged messages to the batch, in the order they were staged */
+static int driver_batch_drain_locked(struct driver_data *dev_data)
+{
+	struct mpsc_node *node;
+	struct driver_staged_msg *msg;
+	struct zvb_bus_iovec iov;
+	int ret = 0;
+	int err;
+
+#ifdef CONFIG_ZVB_BUS_ZVB_PING_PIGGYBACK
+	if (atomic_get(&dev_data->staged_size)) {
+		driver_batch_append_ping_locked(dev_data);
+	}
+#endif
+
+	while ((node = mpsc_pop(&dev_data->staged_q)) != NULL) {
+		msg = CONTAINER_OF(node, struct driver_staged_msg, node);
+		iov.data = msg->data;
+		iov.size = msg->size;
+
+		/* The transmit of a staged message has returned, so its error is only counted */
+		err = driver_batch_append_locked(dev_data, msg->addr, &iov, 1);
+		if (err) {
+			ZVB_BUS_ZVB_ADDR_STATS_INC(&dev_data->stats, msg->addr, tx_drops);
+			ret = err;
+		}
+
+		atomic_sub(&dev_data->staged_size, DRIVER_BATCH_MSG_HEADER_SIZE + msg->size);
+		k_mem_slab_free(&dev_data->staged_msg_slab, msg);
+	}
+
+	return ret;
+}
+#endif /* CONFIG_ZVB_BUS_ZVB_BATCH_STAGING */
+
+static int driver_batch_transmit(struct driver_data *dev_data,
+				 uint8_t addr,
+				 const struct zvb_bus_iovec *iov,
+				 size_t iov_count)
+{
+	int ret;
+
+#ifdef CONFIG_ZVB_BUS_ZVB_BATCH_STAGING
+	if (driver_batch_stage(dev_data, addr, iov, iov_count) == 0) {
+		return 0;
+	}
+#endif
+
+	k_sem_take(&dev_data->transmit_sem, K_FOREVER);
+#ifdef CONFIG_ZVB_BUS_ZVB_BATCH_STAGING
+	/* Keep messages of the calling thread in order */
+	driver_batch_drain_locked(dev_data);
+#endif
+#ifdef CONFIG_ZVB_BUS_ZVB_PING_PIGGYBACK
+	driver_batch_append_ping_locked(dev_data);
+#endif
+	ret = driver_batch_append_locked(dev_data, addr, iov, iov_count);
+	k_sem_give(&dev_data->transmit_sem);
+
+	return ret;
+}
+
+static int driver_batch_flush(struct driver_data *dev_data)
+{
+	int ret;
+
+	k_sem_take(&dev_data->transmit_sem, K_FOREVER);
+#ifdef CONFIG_ZVB_BUS_ZVB_BATCH_STAGING
+	driver_batch_drain_locked(dev_data);
+#endif
+	ret = driver_batch_flush_locked(dev_data);
+	k_sem_give(&dev_data->transmit_sem);
+
+	return ret;
+}
+
+static void driver_flush_dwork_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct driver_data *dev_data = CONTAINER_OF(dwork, struct driver_data, flush_dwork);
+
+	driver_batch_flush(dev_data);
+}
+#endif /* CONFIG_ZVB_BUS_ZVB_BATCH */
+
+#ifdef CONFIG_ZVB_BUS_ZVB_STATS
+static void driver_stats_record_tx(struct driver_data *dev_data,
+				   uint8_t addr,
+				   const struct zvb_bus_iovec *iov,
+				   size_t iov_count,
+				   int ret)
+{
+	size_t size = 0;
+
+	if (ret == -ENOMEM) {
+		ZVB_BUS_ZVB_ADDR_STATS_INC(&dev_data->stats, addr, tx_oversize);
+		return;
+	}
+
+	if (ret < 0) {
+		ZVB_BUS_ZVB_ADDR_STATS_INC(&dev_data->stats, addr, tx_drops);
+		return;
+	}
+
+	for (size_t i = 0; i < iov_count; i++) {
+		size += iov[i].size;
+	}
+
+	ZVB_BUS_ZVB_ADDR_STATS_INC(&dev_data->stats, addr, tx_packets);
+	ZVB_BUS_ZVB_ADDR_STATS_INCN(&dev_data->stats, addr, tx_bytes, size);
+}
+#endif /* CONFIG_ZVB_BUS_ZVB_STATS */
+
+static int driver_api_transmit_iov(const struct device *dev,
+				   uint8_t addr,
+				   const struct zvb_bus_iovec *iov,
+				   size_t iov_count)
+{
+	struct driver_data *dev_data = dev->data;
+	int ret;
+
+	if (iov_count > CONFIG_ZVB_BUS_ZVB_TRANSMIT_IOV_MAX) {
+		ZVB_BUS_ZVB_ADDR_STATS_INC(&dev_data->stats, addr, tx_oversize);
+		return -EINVAL;
+	}
+
+	driver_wait_ready(dev_data);
+
+#ifdef CONFIG_ZVB_BUS_ZVB_BATCH
+	ret = driver_batch_transmit(dev_data, addr, iov, iov_count);
+#else
+	ret = driver_transport_send_iov(dev_data, addr, iov, iov_count);
+#endif
+
+#ifdef CONFIG_ZVB_BUS_ZVB_STATS
+	driver_stats_record_tx(dev_data, addr, iov, iov_count, ret);
+#endif
+
+	return ret;
+}
+
+static int driver_api_transmit(const struct device *dev,
+			       uint8_t addr,
+			       const uint8_t *data,
+			       size_t size)
+{
+	const struct zvb_bus_iovec iov = {
+		.data = data,
+		.size = size,
+	};
+
+	return driver_api_transmit_iov(dev, addr, &iov, 1);
+}
+
+#ifdef CONFIG_ZVB_BUS_ZVB_BATCH
+static int driver_api_flush(const struct device *dev)
+{
+	struct driver_data *dev_data = dev->data;
+
+	driver_wait_ready(dev_data);
+
+	return driver_batch_flush(dev_data);
+}
+#endif
+
+#ifdef CONFIG_ZVB_BUS_ZVB_ASYNC_TX
+/* Dequeue oldest message of highest priority */
+static struct driver_tx_msg *driver_tx_msg_get(struct driver_data *dev_data)
+{
+	k_spinlock_key_t key = k_spin_lock(&dev_data->tx_lock);
+	sys_snode_t *node = NULL;
+
+	for (int i = DRIVER_PRIORITY_COUNT - 1; i >= 0 && node == NULL; i--) {
+		node = sys_slist_get(&dev_data->tx_queues[i]);
+	}
+
+	k_spin_unlock(&dev_data->tx_lock, key);
+	return node == NULL ? NULL : CONTAINER_OF(node, struct driver_tx_msg, node);
+}
+
+static void driver_tx_work_handler(struct k_work *work)
+{
+	struct driver_data *dev_data = CONTAINER_OF(work, struct driver_data, tx_work);
+	struct driver_tx_msg *msg;
+	zvb_bus_transmit_callback_t callback;
+	void *user_data;
+	int ret;
+
+	while ((msg = driver_tx_msg_get(dev_data)) != NULL) {
+		ret = driver_api_transmit(dev_data->dev, msg->addr, msg->data, msg->size);
+		callback = msg->callback;
+		user_data = msg->user_data;
+
+		/* Free before calling back, so the callback may queue another message */
+		k_mem_slab_free(&dev_data->tx_msg_slab, msg);
+
+		if (callback != NULL) {
+			callback(dev_data->dev, ret, user_data);
+		}
+	}
+
+#ifdef CONFIG_ZVB_BUS_ZVB_BATCH
+	/* Queue is drained, so no more messages can join the batch */
+	driver_api_flush(dev_data->dev);
+#endif
+}
+
+static int driver_api_transmit_async(const struct device *dev,
+				     uint8_t addr,
+				     const uint8_t *data,
+				     size_t size,
+				     zvb_bus_transmit_callback_t callback,
+				     void *user_data)
+{
+	struct driver_data *dev_data = dev->data;
+	struct driver_tx_msg *msg;
+	k_spinlock_key_t key;
+
+	if (size > sizeof(msg->data)) {
+		ZVB_BUS_ZVB_ADDR_STATS_INC(&dev_data->stats, addr, tx_oversize);
+		return -ENOMEM;
+	}
+
+	if (k_mem_slab_alloc(&dev_data->tx_msg_slab, (void **)&msg, K_NO_WAIT)) {
+		ZVB_BUS_ZVB_ADDR_STATS_INC(&dev_data->stats, addr, tx_drops);
+		return -ENOBUFS;
+	}
+
+	msg->callback = callback;
+	msg->user_data = user_data;
+	msg->size = size;
+	msg->addr = addr;
+	memcpy(msg->data, data, size);
+
+	key = k_spin_lock(&dev_data->tx_lock);
+	sys_slist_append(&dev_data->tx_queues[driver_priority(dev_data, addr)], &msg->node);
+	k_spin_unlock(&dev_data->tx_lock, key);
+
+	k_work_submit_to_queue(&tx_workq, &dev_data->tx_work);
+	return 0;
+}
+
+static void driver_tx_start(void)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "zvb_bus_tx",
+	};
+
+	if (tx_started) {
+		return;
+	}
+
+	k_work_queue_init(&tx_workq);
+	k_work_queue_start(&tx_workq,
+			   tx_workq_stack,
+			   K_THREAD_STACK_SIZEOF(tx_workq_stack),
+			   CONFIG_ZVB_BUS_ZVB_ASYNC_TX_THREAD_PRIORITY,
+			   &cfg);
+	tx_started = true;
+}
+#endif /* CONFIG_ZVB_BUS_ZVB_ASYNC_TX */
+
+#ifdef CONFIG_ZVB_BUS_ZVB_LOCKSTEP
+/* Report reaching the granted time to the host, after any queued messages */
+static int driver_lockstep_ack(const struct device *dev, int64_t uptime_us)
+{
+	uint8_t data[sizeof(uint64_t)];
+	int ret;
+
+	sys_put_le64((uint64_t)uptime_us, data);
+
+	ret = driver_api_transmit(dev, DRIVER_TICK_ADDRESS, data, sizeof(data));
+
+#ifdef CONFIG_ZVB_BUS_ZVB_BATCH
+	if (ret == 0) {
+		ret = driver_api_flush(dev);
+	}
+#endif
+
+	return ret;
+}
+#endif /* CONFIG_ZVB_BUS_ZVB_LOCKSTEP */
+
+#ifdef CONFIG_ZVB_BUS_RTIO
+static uint8_t driver_rtio_addr(const struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct zvb_bus_dt_spec *dt_spec = iodev_sqe->sqe.iodev->data;
+
+	return dt_spec->addr;
+}
+
+static void driver_rtio_rx_push(struct driver_data *dev_data, struct rtio_iodev_sqe *iodev_sqe)
+{
+	k_spinlock_key_t key = k_spin_lock(&dev_data->rtio_lock);
+
+	iodev_sqe->next = NULL;
+
+	if (dev_data->rtio_rx_tail == NULL) {
+		dev_data->rtio_rx_head = iodev_sqe;
+	} else {
+		dev_data->rtio_rx_tail->next = iodev_sqe;
+	}
+
+	dev_data->rtio_rx_tail = iodev_sqe;
+	k_spin_unlock(&dev_data->rtio_lock, key);
+}
+
+/* Remove oldest read matching addr, or iodev_sqe if not NULL */
+static struct rtio_iodev_sqe *driver_rtio_rx_pop(struct driver_data *dev_data,
+						 uint8_t addr,
+						 const struct rtio_iodev_sqe *iodev_sqe)
+{
+	k_spinlock_key_t key = k_spin_lock(&dev_data->rtio_lock);
+	struct rtio_iodev_sqe *prev = NULL;
+	struct rtio_iodev_sqe *curr = dev_data->rtio_rx_head;
+
+	while (curr != NULL) {
+		if (iodev_sqe != NULL ? curr == iodev_sqe : driver_rtio_addr(curr) == addr) {
+			break;
+		}
+
+		prev = curr;
+		curr = curr->next;
+	}
+
+	if (curr != NULL) {
+		if (prev == NULL) {
+			dev_data->rtio_rx_head = curr->next;
+		} else {
+			prev->next = curr->next;
+		}
+
+		if (dev_data->rtio_rx_tail == curr) {
+			dev_data->rtio_rx_tail = prev;
+		}
+	}
+
+	k_spin_unlock(&dev_data->rtio_lock, key);
+	return curr;
+}
+
+static void driver_rtio_rx_complete(struct rtio_iodev_sqe *iodev_sqe,
+				    const uint8_t *msg,
+				    size_t msg_size)
+{
+	const struct rtio_sqe *sqe = &iodev_sqe->sqe;
+	uint8_t *buf;
+	uint32_t buf_len;
+
+	if (sqe->op == RTIO_OP_TXRX) {
+		buf = sqe->txrx.rx_buf;
+		buf_len = sqe->txrx.buf_len;
+	} else if (rtio_sqe_rx_buf(iodev_sqe, msg_size, msg_size, &buf, &buf_len)) {
+		buf_len = 0;
+	}
 
-#define DRIVER_PING_ADDRESS 0xFF
+	if (buf_len < msg_size) {
+		rtio_iodev_sqe_err(iodev_sqe, -ENOMEM);
+		return;
+	}
 
-static K_SEM_DEFINE(receive_sem, 1, 1);
-static K_SEM_DEFINE(transmit_sem, 0, 1);
-static sys_slist_t callbacks;
-static uint8_t receive_buf[CONFIG_ZVB_BUS_ZVB_TRANSFER_BUF_SIZE];
-static uint8_t transmit_buf[CONFIG_ZVB_BUS_ZVB_TRANSFER_BUF_SIZE];
-static uint32_t tick;
-static int socket_fd;
-static int64_t ping_uptime_ms;
-static struct sockaddr_in socket_addr;
-static struct k_work_delayable driver_ping_dwork;
+	memcpy(buf, msg, msg_size);
+	rtio_iodev_sqe_ok(iodev_sqe, (int)msg_size);
+}
 
-static inline int driver_socket_send(const uint8_t *data, size_t size)
+/* Complete oldest read from msg_addr with msg, returns true if there was one */
+static bool driver_rtio_receive(struct driver_data *dev_data,
+				uint8_t msg_addr,
+				const uint8_t *msg,
+				size_t msg_size)
 {
-	int ret;
+	struct rtio_iodev_sqe *iodev_sqe = driver_rtio_rx_pop(dev_data, msg_addr, NULL);
 
-	ret = zsock_sendto(socket_fd,
-			   data,
-			   size,
-			   0,
-			   (struct sockaddr *)&socket_addr,
-			   sizeof(socket_addr));
+	if (iodev_sqe == NULL) {
+		return false;
+	}
 
-	return ret == size ? 0 : -EIO;
+	driver_rtio_rx_complete(iodev_sqe, msg, msg_size);
+	return true;
 }
 
-static void driver_ping_dwork_handler(struct k_work *work)
+#ifdef CONFIG_ZVB_BUS_ZVB_SEQ
+/* The awaited messages may have been lost, so fail every pending read */
+static void driver_rtio_rx_fail_all(struct driver_data *dev_data, int result)
 {
-	uint8_t data[sizeof(uint8_t) + sizeof(uint32_t)];
+	k_spinlock_key_t key = k_spin_lock(&dev_data->rtio_lock);
+	struct rtio_iodev_sqe *iodev_sqe = dev_data->rtio_rx_head;
+	struct rtio_iodev_sqe *next;
 
-	data[0] = DRIVER_PING_ADDRESS;
-	sys_put_le32(tick, &data[1]);
-	tick++;
-	ping_uptime_ms = k_uptime_get();
-	driver_socket_send(data, sizeof(data));
-	k_work_schedule(&driver_ping_dwork, K_MSEC(CONFIG_ZVB_BUS_ZVB_PING_INTERVAL_MS));
+	dev_data->rtio_rx_head = NULL;
+	dev_data->rtio_rx_tail = NULL;
+	k_spin_unlock(&dev_data->rtio_lock, key);
+
+	while (iodev_sqe != NULL) {
+		next = iodev_sqe->next;
+		rtio_iodev_sqe_err(iodev_sqe, result);
+		iodev_sqe = next;
+	}
 }
+#endif
 
-static int driver_api_add_receive_callback(const struct device *dev,
-					   struct zvb_bus_receive_callback *callback)
+static void driver_api_iodev_submit(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
 {
-	ARG_UNUSED(dev);
+	struct driver_data *dev_data = dev->data;
+	const struct rtio_sqe *sqe = &iodev_sqe->sqe;
+	uint8_t addr = driver_rtio_addr(iodev_sqe);
+	int ret;
 
-	if (callback->handler == NULL) {
-		return -EINVAL;
-	}
+	switch (sqe->op) {
+	case RTIO_OP_TX:
+		ret = driver_api_transmit(dev, addr, sqe->tx.buf, sqe->tx.buf_len);
+		break;
 
-	k_sem_take(&receive_sem, K_FOREVER);
-	sys_slist_find_and_remove(&callbacks, &callback->node);
-	sys_slist_append(&callbacks, &callback->node);
-	k_sem_give(&receive_sem);
+	case RTIO_OP_TINY_TX:
+		ret = driver_api_transmit(dev, addr, sqe->tiny_tx.buf, sqe->tiny_tx.buf_len);
+		break;
 
-	return 0;
-}
+	case RTIO_OP_RX:
+		driver_rtio_rx_push(dev_data, iodev_sqe);
+		return;
 
-static int driver_api_remove_receive_callback(const struct device *dev,
-					      struct zvb_bus_receive_callback *callback)
-{
-	ARG_UNUSED(dev);
+	case RTIO_OP_TXRX:
+		/* Queue read before transmitting, so the reply can't be missed */
+		driver_rtio_rx_push(dev_data, iodev_sqe);
+		ret = driver_api_transmit(dev, addr, sqe->txrx.tx_buf, sqe->txrx.buf_len);
+		if (ret == 0 || driver_rtio_rx_pop(dev_data, addr, iodev_sqe) == NULL) {
+			return;
+		}
 
-	k_sem_take(&receive_sem, K_FOREVER);
-	sys_slist_find_and_remove(&callbacks, &callback->node);
-	k_sem_give(&receive_sem);
+		break;
 
-	return 0;
+	default:
+		ret = -ENOTSUP;
+		break;
+	}
+
+	if (ret) {
+		rtio_iodev_sqe_err(iodev_sqe, ret);
+	} else {
+		rtio_iodev_sqe_ok(iodev_sqe, 0);
+	}
 }
+#endif /* CONFIG_ZVB_BUS_RTIO */
 
-static int driver_api_transmit(const struct device *dev,
-			       uint8_t addr,
-			       const uint8_t *data,
-			       size_t size)
+#ifdef CONFIG_ZVB_BUS_ZVB_RX_POOL
+static int driver_api_receive_buf_ref(const struct device *dev,
+				      const uint8_t *data,
+				      struct net_buf **buf)
 {
-	int ret;
+	struct driver_data *dev_data = dev->data;
+	struct net_buf *rx_buf = NULL;
+
+	/* Only the thread handling a buffer may take a reference to it */
+	if (k_current_get() == dev_data->receive_tid) {
+		rx_buf = dev_data->rx_buf;
+	}
 
-	ARG_UNUSED(dev);
+#ifdef CONFIG_ZVB_BUS_ZVB_DEFERRED
+	if (k_current_get() == k_work_queue_thread_get(&dev_data->deferred_workq)) {
+		rx_buf = dev_data->deferred_buf;
+	}
+#endif
 
-	if (sizeof(transmit_buf) <= size) {
+	if (!driver_rx_buf_holds(rx_buf, data)) {
 		return -ENOMEM;
 	}
 
-	k_sem_take(&transmit_sem, K_FOREVER);
-	transmit_buf[0] = addr;
-	memcpy(&transmit_buf[1], data, size);
-	ret = driver_socket_send(transmit_buf, size + 1);
-	k_sem_give(&transmit_sem);
+	*buf = net_buf_ref(rx_buf);
+	return 0;
+}
+#endif
+
+#ifdef CONFIG_ZVB_BUS_ZVB_CLOCK_SYNC
+static int driver_api_host_time_to_uptime(const struct device *dev,
+					  uint64_t host_time_us,
+					  int64_t *uptime_ns)
+{
+	struct driver_data *dev_data = dev->data;
 
-	return ret;
+	return zvb_bus_zvb_clock_to_uptime(&dev_data->clock,
+					   (int64_t)(host_time_us * NSEC_PER_USEC),
+					   uptime_ns);
 }
+#endif
 
 static DEVICE_API(zvb_bus, driver_api) = {
 	.add_receive_callback = driver_api_add_receive_callback,
 	.remove_receive_callback = driver_api_remove_receive_callback,
 	.transmit = driver_api_transmit,
+	.transmit_iov = driver_api_transmit_iov,
+#ifdef CONFIG_ZVB_BUS_ZVB_BATCH
+	.flush = driver_api_flush,
+#endif
+#ifdef CONFIG_ZVB_BUS_ZVB_ASYNC_TX
+	.transmit_async = driver_api_transmit_async,
+#endif
+#ifdef CONFIG_ZVB_BUS_ZVB_RX_POOL
+	.receive_buf_ref = driver_api_receive_buf_ref,
+#endif
+#ifdef CONFIG_ZVB_BUS_RTIO
+	.iodev_submit = driver_api_iodev_submit,
+#endif
+#ifdef CONFIG_ZVB_BUS_ZVB_CLOCK_SYNC
+	.host_time_to_uptime = driver_api_host_time_to_uptime,
+#endif
 };
 
-static void handle_received_data(const uint8_t *data, size_t size)
+struct zvb_bus_zvb_stats_data *zvb_bus_zvb_stats_data_get(const struct device *dev)
+{
+	struct driver_data *dev_data = dev->data;
+
+	if (dev->api != &driver_api) {
+		return NULL;
+	}
+
+	return &dev_data->stats;
+}
+
+#ifdef CONFIG_ZVB_BUS_ZVB_CLOCK_SYNC
+struct zvb_bus_zvb_clock *zvb_bus_zvb_clock_data_get(const struct device *dev)
+{
+	struct driver_data *dev_data = dev->data;
+
+	if (dev->api != &driver_api) {
+		return NULL;
+	}
+
+	return &dev_data->clock;
+}
+#endif
+
+#ifdef CONFIG_ZVB_BUS_ZVB_CLOCK_SYNC
+/*
+ * Pongs echo the tick of the ping, and may be followed by the host time in
+ * microseconds (le64) at which the host handled the ping.
+ */
+static void driver_clock_sync(struct driver_data *dev_data,
+			      const uint8_t *msg,
+			      size_t msg_size,
+			      uint32_t rtt_ns)
+{
+	uint64_t host_time_us;
+
+	if (msg_size < (sizeof(uint32_t) + sizeof(uint64_t))) {
+		return;
+	}
+
+	host_time_us = sys_get_le64(&msg[sizeof(uint32_t)]);
+	zvb_bus_zvb_clock_update(&dev_data->clock,
+				 dev_data->ping_uptime_ns,
+				 rtt_ns,
+				 (int64_t)(host_time_us * NSEC_PER_USEC));
+}
+#endif /* CONFIG_ZVB_BUS_ZVB_CLOCK_SYNC */
+
+static void driver_handle_pong(struct driver_data *dev_data, const uint8_t *msg, size_t msg_size)
 {
-	uint8_t msg_addr;
+	uint32_t rtt_ns;
+
+	if (msg_size < sizeof(uint32_t)) {
+		LOG_WRN("Got too small pong");
+		return;
+	}
+
+	/* A late pong to an earlier ping would skew the samples */
+	if (sys_get_le32(msg) != dev_data->ping_tick) {
+		return;
+	}
+
+	/* Only the first pong to each ping is a valid sample */
+	if (!atomic_cas(&dev_data->ping_pending, 1, 0)) {
+		return;
+	}
+
+	rtt_ns = (uint32_t)MIN(k_cyc_to_ns_floor64(k_cycle_get_32() - dev_data->ping_cycles),
+			       UINT32_MAX);
+	LOG_DBG("Pong: rtt: %uns", rtt_ns);
+	zvb_bus_zvb_stats_record_rtt(&dev_data->stats, rtt_ns);
+
+#ifdef CONFIG_ZVB_BUS_ZVB_CLOCK_SYNC
+	driver_clock_sync(dev_data, msg, msg_size, rtt_ns);
+#endif
+}
+
+static void handle_received_msg(struct driver_data *dev_data,
+				uint8_t msg_addr,
+				const uint8_t *msg,
+				size_t msg_size)
+{
+	struct zvb_bus_receive_callback *callback;
+	sys_slist_t *list = &dev_data->callbacks[msg_addr];
+
+	LOG_DBG("Received packet: addr: %u", msg_addr);
+	LOG_HEXDUMP_DBG(msg, msg_size, "data: ");
+
+	if (msg_addr == DRIVER_PING_ADDRESS) {
+		driver_handle_pong(dev_data, msg, msg_size);
+		return;
+	}
+
+#ifdef CONFIG_ZVB_BUS_ZVB_LOCKSTEP
+	if (msg_addr == DRIVER_TICK_ADDRESS) {
+		if (msg_size < sizeof(uint64_t)) {
+			LOG_WRN("Got too small tick");
+			return;
+		}
+
+		dev_data->lockstep_grant_us = (int64_t)sys_get_le64(msg);
+		return;
+	}
+#endif
+
+	ZVB_BUS_ZVB_ADDR_STATS_INC(&dev_data->stats, msg_addr, rx_packets);
+	ZVB_BUS_ZVB_ADDR_STATS_INCN(&dev_data->stats, msg_addr, rx_bytes, msg_size);
+
+#ifdef CONFIG_ZVB_BUS_RTIO
+	/* Messages complete the oldest pending RTIO read, and are passed to callbacks too */
+	if (driver_rtio_receive(dev_data, msg_addr, msg, msg_size) && sys_slist_is_empty(list)) {
+		return;
+	}
+#endif
+
+	if (sys_slist_is_empty(list)) {
+		ZVB_BUS_ZVB_ADDR_STATS_INC(&dev_data->stats, msg_addr, rx_drops);
+		return;
+	}
+
+	driver_dispatch_begin(dev_data);
+	for (callback = driver_dispatch_next(dev_data, sys_slist_peek_head(list));
+	     callback != NULL;
+	     callback = driver_dispatch_next(dev_data, dev_data->dispatch_next)) {
+#ifdef CONFIG_ZVB_BUS_ZVB_DEFERRED
+		if (callback->dispatch == ZVB_BUS_DISPATCH_DEFERRED) {
+			driver_deferred_dispatch(dev_data, callback, msg, msg_size);
+			continue;
+		}
+#endif
+
+		driver_call_handler(dev_data->dev, callback, msg, msg_size);
+	}
+	driver_dispatch_end(dev_data);
+}
+
+static void handle_received_batch(struct driver_data *dev_data, const uint8_t *data, size_t size)
+{
+	struct zvb_bus_zvb_batch_iter iter;
+	const uint8_t *header;
 	const uint8_t *msg;
 	size_t msg_size;
+	int ret;
+
+	zvb_bus_zvb_batch_iter_init(&iter, data, size, DRIVER_MSG_HEADER_SIZE);
+
+	while ((ret = zvb_bus_zvb_batch_next(&iter, &header, &msg, &msg_size)) == 0) {
+		if (msg_size == 0) {
+			LOG_WRN("Got too small packet");
+			continue;
+		}
+
+		handle_received_msg(dev_data, header[0], msg, msg_size);
+	}
+
+	if (ret == -EBADMSG) {
+		LOG_WRN("Got truncated batch");
+	}
+}
+
+#ifdef CONFIG_ZVB_BUS_ZVB_SEQ
+/* Check sequence number of received datagram, returns number of lost datagrams */
+static int driver_seq_check(struct driver_data *dev_data, uint8_t flags, uint16_t seq)
+{
+	uint16_t expected = dev_data->rx_seq.next;
+	int lost;
+
+	lost = zvb_bus_zvb_seq_check(&dev_data->rx_seq, flags & DRIVER_SEQ_FLAG_SYNC, seq);
+
+	if (lost < 0) {
+		LOG_WRN("Got late datagram: seq: %u, expected: %u", seq, expected);
+		zvb_bus_zvb_stats_record_reordered(&dev_data->stats);
+	} else if (lost > 0) {
+		LOG_WRN("Lost %d datagrams before seq: %u", lost, seq);
+		zvb_bus_zvb_stats_record_lost(&dev_data->stats, lost);
+	}
+
+	return lost;
+}
+
+static void driver_notify_loss(struct driver_data *dev_data, uint32_t count)
+{
 	struct zvb_bus_receive_callback *callback;
 
+	driver_dispatch_begin(dev_data);
+	for (size_t i = 0; i < ARRAY_SIZE(dev_data->callbacks); i++) {
+		for (callback = driver_dispatch_next(dev_data,
+						     sys_slist_peek_head(&dev_data->callbacks[i]));
+		     callback != NULL;
+		     callback = driver_dispatch_next(dev_data, dev_data->dispatch_next)) {
+			if (callback->loss_handler != NULL) {
+				callback->loss_handler(dev_data->dev, callback, count);
+			}
+		}
+	}
+	driver_dispatch_end(dev_data);
+
+#ifdef CONFIG_ZVB_BUS_RTIO
+	driver_rtio_rx_fail_all(dev_data, -EIO);
+#endif
+}
+#endif /* CONFIG_ZVB_BUS_ZVB_SEQ */
+
+static void handle_received_frame(struct driver_data *dev_data, const uint8_t *data, size_t size)
+{
 	if (size < 2) {
 		LOG_WRN("Got too small packet");
 		return;
 	}
 
-	msg_addr = data[0];
-	msg = &data[1];
-	msg_size = size - 1;
+	if (data[0] == DRIVER_BATCH_ADDRESS) {
+		handle_received_batch(dev_data, &data[1], size - 1);
+		return;
+	}
 
-	LOG_DBG("Received packet: addr: %u", msg_addr);
-	LOG_HEXDUMP_DBG(msg, msg_size, "data: ");
+	if (size <= DRIVER_MSG_HEADER_SIZE) {
+		LOG_WRN("Got too small packet");
+		return;
+	}
 
-	if (msg_addr == DRIVER_PING_ADDRESS) {
-		LOG_INF("Pong: latency: %llims", k_uptime_get() - ping_uptime_ms);
+	handle_received_msg(dev_data,
+			    data[0],
+			    &data[DRIVER_MSG_HEADER_SIZE],
+			    size - DRIVER_MSG_HEADER_SIZE);
+}
+
+static void handle_received_data(struct driver_data *dev_data, const uint8_t *data, size_t size)
+{
+#ifdef CONFIG_ZVB_BUS_ZVB_SEQ
+	int lost;
+
+	if (size < DRIVER_SEQ_HEADER_SIZE) {
+		LOG_WRN("Got too small packet");
+		return;
+	}
+
+	lost = driver_seq_check(dev_data, data[0], sys_get_le16(&data[1]));
+	if (lost < 0) {
 		return;
 	}
 
-	k_sem_take(&receive_sem, K_FOREVER);
-	SYS_SLIST_FOR_EACH_CONTAINER(&callbacks, callback, node) {
-		if (callback->addr == msg_addr) {
-			callback->handler(DEVICE_DT_INST_GET(0), callback, msg, msg_size);
+	handle_received_frame(dev_data, &data[DRIVER_SEQ_HEADER_SIZE], size - DRIVER_SEQ_HEADER_SIZE);
+
+	/* Notify after handling the datagram, which may contain an awaited reply */
+	if (lost > 0) {
+		driver_notify_loss(dev_data, lost);
+	}
+#else
+	handle_received_frame(dev_data, data, size);
+#endif
+}
+
+/*
+ * Drop datagram truncated to the receive buffer, which the sequence check
+ * then reports as lost
+ */
+static void handle_truncated_data(struct driver_data *dev_data, const uint8_t *data, size_t size)
+{
+	size_t offset = IS_ENABLED(CONFIG_ZVB_BUS_ZVB_SEQ) ? DRIVER_SEQ_HEADER_SIZE : 0;
+
+	LOG_WRN("Got too large packet (%zu bytes)", size);
+	zvb_bus_zvb_stats_record_rx_truncated(&dev_data->stats);
+
+	/* Batches carry messages of several devices */
+	if (data[offset] != DRIVER_BATCH_ADDRESS) {
+		ZVB_BUS_ZVB_ADDR_STATS_INC(&dev_data->stats, data[offset], rx_oversize);
+	}
+}
+
+#ifdef CONFIG_ZVB_BUS_ZVB_CAPTURE
+static void driver_capture_rx(struct driver_data *dev_data, const uint8_t *data, size_t size)
+{
+	const struct zvb_bus_iovec iov = {
+		.data = data,
+		.size = size,
+	};
+
+	zvb_bus_zvb_capture_record(&dev_data->capture, ZVB_BUS_ZVB_CAPTURE_RX, &iov, 1);
+}
+#endif
+
+/* Get buffer to receive next datagram into, of size CONFIG_ZVB_BUS_ZVB_TRANSFER_BUF_SIZE */
+static uint8_t *driver_rx_buf_alloc(struct driver_data *dev_data)
+{
+#ifdef CONFIG_ZVB_BUS_ZVB_RX_POOL
+	const struct driver_config *dev_config = dev_data->dev->config;
+
+	dev_data->rx_buf = net_buf_alloc(dev_config->rx_pool, K_NO_WAIT);
+	if (dev_data->rx_buf != NULL) {
+		return dev_data->rx_buf->data;
+	}
+
+	/* Handlers hold every pooled buffer, so they will have to copy */
+	LOG_DBG("Receive buffer pool empty");
+#endif
+
+	return dev_data->receive_buf;
+}
+
+static void driver_rx_buf_free(struct driver_data *dev_data)
+{
+#ifdef CONFIG_ZVB_BUS_ZVB_RX_POOL
+	if (dev_data->rx_buf != NULL) {
+		net_buf_unref(dev_data->rx_buf);
+		dev_data->rx_buf = NULL;
+	}
+#else
+	ARG_UNUSED(dev_data);
+#endif
+}
+
+/* Receive and handle every pending datagram, without blocking */
+static int driver_receive_pending(struct driver_data *dev_data)
+{
+	uint32_t burst = 0;
+	uint8_t *buf;
+	int ret;
+
+	while (1) {
+		buf = driver_rx_buf_alloc(dev_data);
+		ret = zvb_bus_zvb_transport_recv(&dev_data->transport,
+						 buf,
+						 CONFIG_ZVB_BUS_ZVB_TRANSFER_BUF_SIZE);
+		if (ret == -EAGAIN) {
+			driver_rx_buf_free(dev_data);
+			break;
+		}
+
+		if (ret < 0) {
+			driver_rx_buf_free(dev_data);
+			return ret;
+		}
+
+		if (ret > CONFIG_ZVB_BUS_ZVB_TRANSFER_BUF_SIZE) {
+			handle_truncated_data(dev_data, buf, ret);
+			driver_rx_buf_free(dev_data);
+			burst++;
+			continue;
+		}
+
+#ifdef CONFIG_ZVB_BUS_ZVB_CAPTURE
+		driver_capture_rx(dev_data, buf, ret);
+#endif
+
+		handle_received_data(dev_data, buf, ret);
+		driver_rx_buf_free(dev_data);
+		burst++;
+	}
+
+	zvb_bus_zvb_stats_record_rx(&dev_data->stats, burst);
+	return 0;
+}
+
+#ifdef CONFIG_ZVB_BUS_ZVB_LOCKSTEP
+/*
+ * Simulated time only advances while some thread sleeps, so sleeping until
+ * the granted time, and blocking the host once it is reached, keeps
+ * simulated time from passing the granted time.
+ */
+static void driver_lockstep_loop(struct driver_data *dev_data)
+{
+	int64_t uptime_us;
+	int64_t acked_us = -1;
+	int ret;
+
+	while (1) {
+		ret = driver_receive_pending(dev_data);
+		if (ret < 0) {
+			LOG_ERR("Receive failed");
+			return;
+		}
+
+		uptime_us = k_ticks_to_us_floor64(k_uptime_ticks());
+		if (uptime_us < dev_data->lockstep_grant_us) {
+			k_sleep(K_TIMEOUT_ABS_US(dev_data->lockstep_grant_us));
+			continue;
+		}
+
+		if (acked_us != dev_data->lockstep_grant_us) {
+			ret = driver_lockstep_ack(dev_data->dev, uptime_us);
+			if (ret < 0) {
+				LOG_ERR("Failed to send tick");
+				return;
+			}
+
+			acked_us = dev_data->lockstep_grant_us;
+		}
+
+		ret = zvb_bus_zvb_transport_wait_host(&dev_data->transport, SYS_FOREVER_US);
+		if (ret < 0) {
+			LOG_ERR("Poll failed");
+			return;
 		}
 	}
-	k_sem_give(&receive_sem);
 }
+#endif /* CONFIG_ZVB_BUS_ZVB_LOCKSTEP */
+
+#ifdef CONFIG_ZVB_BUS_ZVB_HOST_WAIT
+/*
+ * Blocking the host stalls simulated time, so the host is blocked for at most
+ * a system clock tick of real time at once, after which simulated time is
+ * advanced by a tick, and timeouts of the target expire while the host is
+ * quiet.
+ */
+static int driver_transport_wait(struct driver_data *dev_data)
+{
+	int ret;
+
+	while ((ret = zvb_bus_zvb_transport_wait_host(&dev_data->transport,
+						       k_ticks_to_us_ceil32(1))) == -EAGAIN) {
+		k_sleep(K_TICKS(1));
+	}
+
+	return ret;
+}
+#else
+static int driver_transport_wait(struct driver_data *dev_data)
+{
+	return zvb_bus_zvb_transport_wait(&dev_data->transport);
+}
+#endif /* CONFIG_ZVB_BUS_ZVB_HOST_WAIT */
 
 static void driver_thread_routine(void *p1, void *p2, void *p3)
 {
+	const struct device *dev = p1;
+	struct driver_data *dev_data = dev->data;
+	const struct driver_config *dev_config = dev->config;
 	int ret;
-	struct zsock_pollfd pollfd;
 
-	ARG_UNUSED(p1);
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
-	socket_fd = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-	if (socket_fd < 0) {
-		LOG_ERR("Failed to create socket");
+	dev_data->receive_tid = k_current_get();
+
+	ret = zvb_bus_zvb_transport_open(&dev_data->transport, &dev_config->transport);
+	if (ret < 0) {
+		LOG_ERR("Failed to open transport");
 		return;
 	}
 
-	socket_addr.sin_family = AF_INET;
-	net_addr_pton(AF_INET, CONFIG_ZVB_BUS_ZVB_HOST_ADDR, &socket_addr.sin_addr);
-	socket_addr.sin_port = htons(CONFIG_ZVB_BUS_ZVB_HOST_PORT);
-
-	k_sem_give(&transmit_sem);
+	atomic_set(&dev_data->ready, 1);
+	k_sem_give(&dev_data->ready_sem);
 
-	k_work_init_delayable(&driver_ping_dwork, driver_ping_dwork_handler);
-	k_work_schedule(&driver_ping_dwork, K_NO_WAIT);
-
-	pollfd.fd = socket_fd;
-	pollfd.events = POLLIN;
+	k_work_schedule(&dev_data->ping_dwork, K_NO_WAIT);
 
+#ifdef CONFIG_ZVB_BUS_ZVB_LOCKSTEP
+	driver_lockstep_loop(dev_data);
+#else
 	while (1) {
-		ret = zsock_poll(&pollfd, 1, -1);
+		ret = driver_transport_wait(dev_data);
 		if (ret < 0) {
 			LOG_ERR("Poll failed");
 			return;
 		}
 
-		ret = zsock_recv(socket_fd, receive_buf, sizeof(receive_buf), 0);
+		ret = driver_receive_pending(dev_data);
 		if (ret < 0) {
 			LOG_ERR("Receive failed");
 			break;
 		}
+	}
+#endif
+}
+
+static int driver_init(const struct device *dev)
+{
+	struct driver_data *dev_data = dev->data;
+	const struct driver_config *dev_config = dev->config;
+
+	k_sem_init(&dev_data->registry_sem, 1, 1);
+	k_mutex_init(&dev_data->dispatch_mutex);
+	k_condvar_init(&dev_data->dispatch_condvar);
+	k_sem_init(&dev_data->ready_sem, 0, 1);
+	k_work_init_delayable(&dev_data->ping_dwork, driver_ping_dwork_handler);
+#ifdef CONFIG_ZVB_BUS_ZVB_PING_PIGGYBACK
+	/* The first ping is sent on its own, so the host learns of the target */
+	atomic_set(&dev_data->ping_due, CONFIG_ZVB_BUS_ZVB_PING_INTERVAL_MS);
+#endif
+
+#ifdef CONFIG_ZVB_BUS_ZVB_SEQ
+	k_sem_init(&dev_data->tx_seq_sem, 1, 1);
+#endif
+
+#ifdef CONFIG_ZVB_BUS_ZVB_CAPTURE
+	/* Traffic is not captured, but still exchanged, if the file can't be created */
+	zvb_bus_zvb_capture_open(&dev_data->capture, dev_config->capture_file);
+#endif
+
+#ifdef CONFIG_ZVB_BUS_ZVB_BATCH
+	k_sem_init(&dev_data->transmit_sem, 1, 1);
+	k_work_init_delayable(&dev_data->flush_dwork, driver_flush_dwork_handler);
+#ifdef CONFIG_ZVB_BUS_ZVB_BATCH_STAGING
+	mpsc_init(&dev_data->staged_q);
+	k_mem_slab_init(&dev_data->staged_msg_slab,
+			dev_data->staged_msg_buf,
+			sizeof(struct driver_staged_msg),
+			ARRAY_SIZE(dev_data->staged_msg_buf));
+#endif
+#endif
+
+#ifdef CONFIG_ZVB_BUS_ZVB_DEFERRED
+	driver_deferred_start(dev_data, dev_config);
+#endif
+
+#ifdef CONFIG_ZVB_BUS_ZVB_ASYNC_TX
+	k_mem_slab_init(&dev_data->tx_msg_slab,
+			dev_data->tx_msg_buf,
+			sizeof(struct driver_tx_msg),
+			ARRAY_SIZE(dev_data->tx_msg_buf));
+	k_work_init(&dev_data->tx_work, driver_tx_work_handler);
+	driver_tx_start();
+#endif
+
+#ifdef CONFIG_ZVB_BUS_ZVB_STATS
+	zvb_bus_zvb_stats_init(&dev_data->stats,
+			       dev_config->addr_stats,
+			       dev_config->addr_stats_addrs,
+			       dev_config->addr_stats_names,
+			       dev_config->addr_stats_count);
+#endif
+
+	k_thread_create(&dev_data->thread,
+			dev_config->stack,
+			dev_config->stack_size,
+			driver_thread_routine,
+			(void *)dev,
+			NULL,
+			NULL,
+			dev_config->thread_priority,
+			0,
+			K_NO_WAIT);
+
+	k_thread_name_set(&dev_data->thread, dev->name);
+	return 0;
+}
+
+#if defined(CONFIG_ZVB_BUS_ZVB_TRANSPORT_UDP) || defined(CONFIG_ZVB_BUS_ZVB_TRANSPORT_HOST_UDP)
+#define DRIVER_TRANSPORT_CONFIG(inst)								\
+	{											\
+		.host_addr = CONFIG_ZVB_BUS_ZVB_HOST_ADDR,					\
+		.host_port = DT_INST_PROP_OR(inst, port, CONFIG_ZVB_BUS_ZVB_HOST_PORT),		\
+	}
+#elif defined(CONFIG_ZVB_BUS_ZVB_TRANSPORT_SHM)
+#define DRIVER_TRANSPORT_CONFIG(inst)								\
+	{											\
+		.name = DT_INST_PROP_OR(inst, shm_name, CONFIG_ZVB_BUS_ZVB_SHM_NAME),		\
+	}
+#elif defined(CONFIG_ZVB_BUS_ZVB_TRANSPORT_UNIX)
+#define DRIVER_TRANSPORT_CONFIG(inst)								\
+	{											\
+		.socket_path = DT_INST_PROP(inst, socket_path),					\
+	}
+#elif defined(CONFIG_ZVB_BUS_ZVB_TRANSPORT_REPLAY)
+#define DRIVER_TRANSPORT_CONFIG(inst)								\
+	{											\
+		.path = DT_INST_PROP(inst, capture_file),					\
+	}
+#endif
+
+#ifdef CONFIG_ZVB_BUS_ZVB_CAPTURE
+#define DRIVER_CAPTURE_CONFIG(inst)								\
+	.capture_file = DT_INST_PROP(inst, capture_file),
+#else
+#define DRIVER_CAPTURE_CONFIG(inst)
+#endif
+
+#ifdef CONFIG_ZVB_BUS_ZVB_STATS
+#define DRIVER_STATS_DEFINE(inst)								\
+	static STATS_SECT_DECL(zvb_bus_zvb_addr)						\
+		addr_stats##inst[DT_INST_CHILD_NUM_STATUS_OKAY(inst)];				\
+												\
+	static const uint8_t addr_stats_addrs##inst[] = {					\
+		DT_INST_FOREACH_CHILD_STATUS_OKAY_SEP(inst, DT_REG_ADDR, (,))			\
+	};											\
+												\
+	static const char *const addr_stats_names##inst[] = {					\
+		DT_INST_FOREACH_CHILD_STATUS_OKAY_SEP(inst, DT_NODE_FULL_NAME, (,))		\
+	};
+
+#define DRIVER_STATS_CONFIG(inst)								\
+	.addr_stats = addr_stats##inst,								\
+	.addr_stats_addrs = addr_stats_addrs##inst,						\
+	.addr_stats_names = addr_stats_names##inst,						\
+	.addr_stats_count = DT_INST_CHILD_NUM_STATUS_OKAY(inst),
+#else
+#define DRIVER_STATS_DEFINE(inst)
+#define DRIVER_STATS_CONFIG(inst)
+#endif
+
+#ifdef CONFIG_ZVB_BUS_ZVB_RX_POOL
+#define DRIVER_RX_POOL_DEFINE(inst)								\
+	NET_BUF_POOL_FIXED_DEFINE(rx_pool##inst,						\
+				  CONFIG_ZVB_BUS_ZVB_RX_POOL_COUNT,				\
+				  CONFIG_ZVB_BUS_ZVB_TRANSFER_BUF_SIZE,				\
+				  0,								\
+				  NULL);
+
+#define DRIVER_RX_POOL_CONFIG(inst)								\
+	.rx_pool = &rx_pool##inst,
+#else
+#define DRIVER_RX_POOL_DEFINE(inst)
+#define DRIVER_RX_POOL_CONFIG(inst)
+#endif
+
+#ifdef CONFIG_ZVB_BUS_ZVB_DEFERRED
+#define DRIVER_DEFERRED_DEFINE(inst)								\
+	static K_THREAD_STACK_DEFINE(deferred_stack##inst,					\
+				     CONFIG_ZVB_BUS_ZVB_DEFERRED_THREAD_STACK_SIZE);
+
+#define DRIVER_DEFERRED_CONFIG(inst)								\
+	.deferred_stack = deferred_stack##inst,							\
+	.deferred_stack_size = K_THREAD_STACK_SIZEOF(deferred_stack##inst),
+#else
+#define DRIVER_DEFERRED_DEFINE(inst)
+#define DRIVER_DEFERRED_CONFIG(inst)
+#endif
+
+#ifdef CONFIG_ZVB_BUS_ZVB_PRIORITY
+#define DRIVER_ADDR_PRIORITY(node_id)								\
+	[DT_REG_ADDR(node_id)] = DT_PROP_OR(node_id, priority, 0)
+
+/* Pings and ticks measure and gate the whole bus, so they are never delayed */
+#define DRIVER_PRIORITIES_DEFINE(inst)								\
+	static const uint8_t priorities##inst[UINT8_MAX + 1] = {				\
+		[DRIVER_TICK_ADDRESS] = DRIVER_PRIORITY_COUNT - 1,				\
+		[DRIVER_PING_ADDRESS] = DRIVER_PRIORITY_COUNT - 1,				\
+		DT_INST_FOREACH_CHILD_STATUS_OKAY_SEP(inst, DRIVER_ADDR_PRIORITY, (,))		\
+	};
+
+#define DRIVER_PRIORITIES_CONFIG(inst)								\
+	.priorities = priorities##inst,
+#else
+#define DRIVER_PRIORITIES_DEFINE(inst)
+#define DRIVER_PRIORITIES_CONFIG(inst)
+#endif
+
+#define DRIVER_INST_DEFINE(inst)								\
+												\
+	static K_KERNEL_STACK_DEFINE(stack##inst, CONFIG_ZVB_BUS_ZVB_THREAD_STACK_SIZE);	\
+												\
+	DRIVER_STATS_DEFINE(inst)								\
+	DRIVER_RX_POOL_DEFINE(inst)								\
+	DRIVER_DEFERRED_DEFINE(inst)								\
+	DRIVER_PRIORITIES_DEFINE(inst)								\
+												\
+	static struct driver_data data##inst = {						\
+		.dev = DEVICE_DT_INST_GET(inst),						\
+	};											\
+												\
+	static const struct driver_config config##inst = {					\
+		.transport = DRIVER_TRANSPORT_CONFIG(inst),					\
+		.stack = stack##inst,								\
+		.stack_size = K_KERNEL_STACK_SIZEOF(stack##inst),				\
+		.thread_priority = DT_INST_PROP_OR(inst,					\
+						   thread_priority,				\
+						   CONFIG_ZVB_BUS_ZVB_THREAD_PRIORITY),		\
+		DRIVER_PRIORITIES_CONFIG(inst)							\
+		DRIVER_DEFERRED_CONFIG(inst)							\
+		DRIVER_RX_POOL_CONFIG(inst)							\
+		DRIVER_CAPTURE_CONFIG(inst)							\
+		DRIVER_STATS_CONFIG(inst)							\
+	};											\
+												\
+	DEVICE_DT_INST_DEFINE(									\
+		inst,										\
+		driver_init,									\
+		NULL,										\
+		&data##inst,									\
+		&config##inst,									\
+		POST_KERNEL,									\
+		CONFIG_ZVB_BUS_ZVB_INIT_PRIORITY,						\
+		&driver_api									\
+	);
 
-		handle_received_data(receive_buf, ret);
-	}
-}
-
-K_KERNEL_THREAD_DEFINE(
-	zvb_bus_receive_thread,
-	CONFIG_ZVB_BUS_ZVB_THREAD_STACK_SIZE,
-	driver_thread_routine,
-	NULL,
-	NULL,
-	NULL,
-	CONFIG_ZVB_BUS_ZVB_THREAD_PRIORITY,
-	0,
-	0
-);
-
-DEVICE_DT_INST_DEFINE(
-	0,
-	NULL,
-	NULL,
-	NULL,
-	NULL,
-	POST_KERNEL,
-	CONFIG_ZVB_BUS_ZVB_INIT_PRIORITY,
-	&driver_api
-);
+DT_INST_FOREACH_STATUS_OKAY(DRIVER_INST_DEFINE)
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+#include <string.h>
+
+#include "zvb_bus_zvb_capture.h"
+#include "zvb_bus_zvb_file_adapt.h"
+#include "zvb_bus_zvb_transport.h"
+
+LOG_MODULE_DECLARE(zvb_zvb_bus, CONFIG_ZVB_BUS_LOG_LEVEL);
+
+/* Records are prefixed with their header */
+BUILD_ASSERT(1 + ZVB_BUS_ZVB_TRANSPORT_IOV_MAX <= ZVB_BUS_ZVB_FILE_ADAPT_IOV_MAX,
+	     "ZVB_BUS_ZVB_TRANSMIT_IOV_MAX exceeds the file adaptation layer limit");
+
+int zvb_bus_zvb_capture_open(struct zvb_bus_zvb_capture *capture, const char *path)
+{
+	uint8_t header[ZVB_BUS_ZVB_CAPTURE_HEADER_SIZE];
+	const struct zvb_bus_zvb_file_adapt_iovec iov = {
+		.data = header,
+		.size = sizeof(header),
+	};
+
+	k_mutex_init(&capture->lock);
+
+	capture->fd = zvb_bus_zvb_file_adapt_create(path);
+	if (capture->fd < 0) {
+		LOG_ERR("Failed to create capture file %s", path);
+		return -EIO;
+	}
+
+	memcpy(header, ZVB_BUS_ZVB_CAPTURE_MAGIC, ZVB_BUS_ZVB_CAPTURE_MAGIC_SIZE);
+	header[ZVB_BUS_ZVB_CAPTURE_MAGIC_SIZE] = ZVB_BUS_ZVB_CAPTURE_VERSION;
+
+	if (zvb_bus_zvb_file_adapt_write(capture->fd, &iov, 1) < 0) {
+		LOG_ERR("Failed to write capture file %s", path);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+void zvb_bus_zvb_capture_record(struct zvb_bus_zvb_capture *capture,
+				uint8_t direction,
+				const struct zvb_bus_iovec *iov,
+				size_t iov_count)
+{
+	uint8_t header[ZVB_BUS_ZVB_CAPTURE_RECORD_HEADER_SIZE];
+	struct zvb_bus_zvb_file_adapt_iovec file_iov[1 + ZVB_BUS_ZVB_TRANSPORT_IOV_MAX];
+	size_t size;
+	int ret;
+
+	if (capture->fd < 0) {
+		return;
+	}
+
+	file_iov[0].data = header;
+	file_iov[0].size = sizeof(header);
+
+	size = 0;
+	for (size_t i = 0; i < iov_count; i++) {
+		file_iov[i + 1].data = iov[i].data;
+		file_iov[i + 1].size = iov[i].size;
+		size += iov[i].size;
+	}
+
+	/*
+	 * Records are timestamped and appended under the lock to keep them
+	 * ordered, without masking interrupts across the host write.
+	 */
+	k_mutex_lock(&capture->lock, K_FOREVER);
+	sys_put_le64(k_ticks_to_us_floor64(k_uptime_ticks()), &header[0]);
+	header[sizeof(uint64_t)] = direction;
+	sys_put_le16(size, &header[sizeof(uint64_t) + sizeof(uint8_t)]);
+	ret = zvb_bus_zvb_file_adapt_write(capture->fd, file_iov, iov_count + 1);
+	k_mutex_unlock(&capture->lock);
+
+	if (ret < 0) {
+		LOG_WRN("Failed to write capture record");
+	}
+}
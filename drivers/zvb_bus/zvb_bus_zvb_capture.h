@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Capture files start with the magic "ZVBC" followed by a version byte,
+ * followed by any number of records made up of the uptime in microseconds
+ * (le64), the direction (u8), the datagram size (le16) and the datagram,
+ * exactly as exchanged with the host.
+ */
+
+#ifndef ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_CAPTURE_H_
+#define ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_CAPTURE_H_
+
+#include <zvb/drivers/zvb_bus.h>
+#include <zephyr/kernel.h>
+
+#define ZVB_BUS_ZVB_CAPTURE_MAGIC "ZVBC"
+#define ZVB_BUS_ZVB_CAPTURE_MAGIC_SIZE 4
+#define ZVB_BUS_ZVB_CAPTURE_VERSION 1
+#define ZVB_BUS_ZVB_CAPTURE_HEADER_SIZE (ZVB_BUS_ZVB_CAPTURE_MAGIC_SIZE + sizeof(uint8_t))
+#define ZVB_BUS_ZVB_CAPTURE_RECORD_HEADER_SIZE \
+	(sizeof(uint64_t) + sizeof(uint8_t) + sizeof(uint16_t))
+
+/* Datagram received from the host */
+#define ZVB_BUS_ZVB_CAPTURE_RX 0
+/* Datagram transmitted to the host */
+#define ZVB_BUS_ZVB_CAPTURE_TX 1
+
+struct zvb_bus_zvb_capture {
+	/* Held across the host write, so records are only captured from threads */
+	struct k_mutex lock;
+	int fd;
+};
+
+/* Create capture file at path */
+int zvb_bus_zvb_capture_open(struct zvb_bus_zvb_capture *capture, const char *path);
+
+/* Append datagram made up of the buffers in iov to capture file */
+void zvb_bus_zvb_capture_record(struct zvb_bus_zvb_capture *capture,
+				uint8_t direction,
+				const struct zvb_bus_iovec *iov,
+				size_t iov_count);
+
+#endif /* ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_CAPTURE_H_ */
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "zvb_bus_zvb_clock.h"
+
+/* Fraction of the offset error corrected per sample */
+#define CLOCK_OFFSET_GAIN_DIV 8
+/* Fraction of the drift error corrected per sample */
+#define CLOCK_DRIFT_GAIN_DIV 256
+#define CLOCK_DRIFT_MAX_PPB 500000
+
+/* Errors above this are a step of the host clock, like a host restart */
+#define CLOCK_STEP_NS (100 * NSEC_PER_MSEC)
+
+/* NSEC_PER_SEC is unsigned, which would turn negative products unsigned */
+#define CLOCK_NSEC_PER_SEC ((int64_t)NSEC_PER_SEC)
+
+/*
+ * Samples with a round trip time above CLOCK_RTT_REJECT_MUL times the
+ * minimum are likely delayed in one direction only, so they are rejected.
+ * The minimum slowly forgets, to follow changes of the path to the host.
+ */
+#define CLOCK_RTT_REJECT_MUL 4
+#define CLOCK_RTT_MIN_FORGET_DIV 64
+
+static int64_t clock_offset_at(const struct zvb_bus_zvb_clock *clock, int64_t uptime_ns)
+{
+	return clock->offset_ns +
+	       ((uptime_ns - clock->ref_ns) * clock->drift_ppb) / CLOCK_NSEC_PER_SEC;
+}
+
+void zvb_bus_zvb_clock_update(struct zvb_bus_zvb_clock *clock,
+			      int64_t t0_ns,
+			      uint32_t rtt_ns,
+			      int64_t host_ns)
+{
+	/* The host is assumed to have stamped the pong halfway through the round trip */
+	int64_t mid_ns = t0_ns + rtt_ns / 2;
+	int64_t measured_ns = host_ns - mid_ns;
+	int64_t predicted_ns = 0;
+	int64_t error_ns = 0;
+	int64_t dt_ns;
+	int64_t drift_ppb;
+
+	K_SPINLOCK(&clock->lock) {
+		if (clock->synced) {
+			clock->rtt_min_ns += DIV_ROUND_UP(clock->rtt_min_ns,
+							  CLOCK_RTT_MIN_FORGET_DIV);
+			clock->rtt_min_ns = MIN(clock->rtt_min_ns, rtt_ns);
+
+			if (rtt_ns > (uint64_t)clock->rtt_min_ns * CLOCK_RTT_REJECT_MUL) {
+				K_SPINLOCK_BREAK;
+			}
+
+			predicted_ns = clock_offset_at(clock, mid_ns);
+			error_ns = measured_ns - predicted_ns;
+			clock->synced = (error_ns > -(int64_t)CLOCK_STEP_NS) &&
+					(error_ns < (int64_t)CLOCK_STEP_NS);
+		}
+
+		if (!clock->synced) {
+			clock->synced = true;
+			clock->ref_ns = mid_ns;
+			clock->offset_ns = measured_ns;
+			clock->drift_ppb = 0;
+			clock->rtt_min_ns = rtt_ns;
+			K_SPINLOCK_BREAK;
+		}
+
+		dt_ns = mid_ns - clock->ref_ns;
+		if (dt_ns <= 0) {
+			K_SPINLOCK_BREAK;
+		}
+
+		drift_ppb = clock->drift_ppb +
+			    ((error_ns * CLOCK_NSEC_PER_SEC) / dt_ns) / CLOCK_DRIFT_GAIN_DIV;
+
+		clock->drift_ppb = CLAMP(drift_ppb, -CLOCK_DRIFT_MAX_PPB, CLOCK_DRIFT_MAX_PPB);
+		clock->offset_ns = predicted_ns + error_ns / CLOCK_OFFSET_GAIN_DIV;
+		clock->ref_ns = mid_ns;
+	}
+}
+
+int zvb_bus_zvb_clock_to_uptime(struct zvb_bus_zvb_clock *clock,
+				int64_t host_ns,
+				int64_t *uptime_ns)
+{
+	int ret = -EAGAIN;
+
+	K_SPINLOCK(&clock->lock) {
+		if (!clock->synced) {
+			K_SPINLOCK_BREAK;
+		}
+
+		/* Drift is small, so the offset at the uncorrected uptime is accurate */
+		*uptime_ns = host_ns - clock_offset_at(clock, host_ns - clock->offset_ns);
+		ret = 0;
+	}
+
+	return ret;
+}
+
+bool zvb_bus_zvb_clock_get(struct zvb_bus_zvb_clock *clock,
+			   int64_t *offset_ns,
+			   int32_t *drift_ppb)
+{
+	bool synced = false;
+
+	K_SPINLOCK(&clock->lock) {
+		synced = clock->synced;
+		*offset_ns = clock->offset_ns;
+		*drift_ppb = clock->drift_ppb;
+	}
+
+	return synced;
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_CLOCK_H_
+#define ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_CLOCK_H_
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+
+/*
+ * Estimate of the host clock relative to the target uptime. The offset is
+ * host time minus target uptime at target uptime ref_ns, and changes by
+ * drift_ppb nanoseconds per second of target uptime.
+ */
+struct zvb_bus_zvb_clock {
+	struct k_spinlock lock;
+	bool synced;
+	int64_t ref_ns;
+	int64_t offset_ns;
+	int32_t drift_ppb;
+	uint32_t rtt_min_ns;
+};
+
+/* Get clock estimate of bus device instance */
+struct zvb_bus_zvb_clock *zvb_bus_zvb_clock_data_get(const struct device *dev);
+
+/*
+ * Update estimate with a ping sent at target uptime t0_ns, answered by a pong
+ * stamped with host time host_ns, received rtt_ns later
+ */
+void zvb_bus_zvb_clock_update(struct zvb_bus_zvb_clock *clock,
+			      int64_t t0_ns,
+			      uint32_t rtt_ns,
+			      int64_t host_ns);
+
+/* Map host time to target uptime, returns -EAGAIN if not yet synced */
+int zvb_bus_zvb_clock_to_uptime(struct zvb_bus_zvb_clock *clock,
+				int64_t host_ns,
+				int64_t *uptime_ns);
+
+/* Get current offset and drift, returns false if not yet synced */
+bool zvb_bus_zvb_clock_get(struct zvb_bus_zvb_clock *clock,
+			   int64_t *offset_ns,
+			   int32_t *drift_ppb);
+
+#endif /* ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_CLOCK_H_ */
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host side of the zvb bus capture file access. This file is built with the
+ * host libc, and is called directly from the embedded side.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "zvb_bus_zvb_file_adapt.h"
+
+int zvb_bus_zvb_file_adapt_create(const char *path)
+{
+	int fd;
+
+	fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+	return fd < 0 ? ZVB_BUS_ZVB_FILE_ADAPT_ERR : fd;
+}
+
+int zvb_bus_zvb_file_adapt_open(const char *path)
+{
+	int fd;
+
+	fd = open(path, O_RDONLY | O_CLOEXEC);
+	return fd < 0 ? ZVB_BUS_ZVB_FILE_ADAPT_ERR : fd;
+}
+
+int zvb_bus_zvb_file_adapt_write(int fd,
+				 const struct zvb_bus_zvb_file_adapt_iovec *iov,
+				 size_t iov_count)
+{
+	struct iovec file_iov[ZVB_BUS_ZVB_FILE_ADAPT_IOV_MAX];
+	ssize_t size;
+	ssize_t ret;
+
+	if (iov_count > ZVB_BUS_ZVB_FILE_ADAPT_IOV_MAX) {
+		return ZVB_BUS_ZVB_FILE_ADAPT_ERR;
+	}
+
+	size = 0;
+	for (size_t i = 0; i < iov_count; i++) {
+		file_iov[i].iov_base = (void *)iov[i].data;
+		file_iov[i].iov_len = iov[i].size;
+		size += iov[i].size;
+	}
+
+	do {
+		ret = writev(fd, file_iov, iov_count);
+	} while ((ret < 0) && (errno == EINTR));
+
+	return ret == size ? 0 : ZVB_BUS_ZVB_FILE_ADAPT_ERR;
+}
+
+int zvb_bus_zvb_file_adapt_read(int fd, void *buf, size_t size)
+{
+	size_t offset = 0;
+	ssize_t ret;
+
+	while (offset < size) {
+		ret = read(fd, (uint8_t *)buf + offset, size - offset);
+		if ((ret < 0) && (errno == EINTR)) {
+			continue;
+		}
+
+		if (ret < 0) {
+			return ZVB_BUS_ZVB_FILE_ADAPT_ERR;
+		}
+
+		if (ret == 0) {
+			return offset == 0 ? 0 : ZVB_BUS_ZVB_FILE_ADAPT_ERR;
+		}
+
+		offset += ret;
+	}
+
+	return size;
+}
+
+int zvb_bus_zvb_file_adapt_skip(int fd, size_t size)
+{
+	return lseek(fd, size, SEEK_CUR) < 0 ? ZVB_BUS_ZVB_FILE_ADAPT_ERR : 0;
+}
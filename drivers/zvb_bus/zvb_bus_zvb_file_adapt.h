@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host file access for capturing and replaying zvb bus traffic. This header
+ * is included both by the embedded side of the driver and by the host side
+ * adaptation layer, so it must not depend on Zephyr headers.
+ */
+
+#ifndef ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_FILE_ADAPT_H_
+#define ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_FILE_ADAPT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ZVB_BUS_ZVB_FILE_ADAPT_ERR -1
+
+/* Maximum number of buffers appended by a single write */
+#define ZVB_BUS_ZVB_FILE_ADAPT_IOV_MAX 16
+
+struct zvb_bus_zvb_file_adapt_iovec {
+	const void *data;
+	size_t size;
+};
+
+/* Create or truncate file at path for writing, returns file or ZVB_BUS_ZVB_FILE_ADAPT_ERR */
+int zvb_bus_zvb_file_adapt_create(const char *path);
+
+/* Open existing file at path for reading, returns file or ZVB_BUS_ZVB_FILE_ADAPT_ERR */
+int zvb_bus_zvb_file_adapt_open(const char *path);
+
+/* Append the buffers in iov to file */
+int zvb_bus_zvb_file_adapt_write(int fd,
+				 const struct zvb_bus_zvb_file_adapt_iovec *iov,
+				 size_t iov_count);
+
+/*
+ * Read exactly size bytes from file, returns size, 0 at end of file, or
+ * ZVB_BUS_ZVB_FILE_ADAPT_ERR if the file ends within the read
+ */
+int zvb_bus_zvb_file_adapt_read(int fd, void *buf, size_t size);
+
+/* Skip size bytes of file */
+int zvb_bus_zvb_file_adapt_skip(int fd, size_t size);
+
+#endif /* ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_FILE_ADAPT_H_ */
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "zvb_bus_zvb_frame.h"
+
+int zvb_bus_zvb_seq_check(struct zvb_bus_zvb_seq *seq, bool sync, uint16_t value)
+{
+	int16_t delta;
+
+	if (sync || !seq->synced) {
+		seq->next = value + 1;
+		seq->synced = true;
+		return 0;
+	}
+
+	/* Sequence numbers wrap, so only their distance is compared */
+	delta = (int16_t)(value - seq->next);
+
+	if (delta < 0) {
+		return -EALREADY;
+	}
+
+	seq->next = value + 1;
+	return delta;
+}
+
+void zvb_bus_zvb_batch_iter_init(struct zvb_bus_zvb_batch_iter *iter,
+				 const uint8_t *data,
+				 size_t size,
+				 size_t header_size)
+{
+	iter->data = data;
+	iter->size = size;
+	iter->header_size = header_size;
+}
+
+int zvb_bus_zvb_batch_next(struct zvb_bus_zvb_batch_iter *iter,
+			   const uint8_t **header,
+			   const uint8_t **msg,
+			   size_t *msg_size)
+{
+	size_t size;
+
+	if (iter->size == 0) {
+		return -ENODATA;
+	}
+
+	if (iter->size < iter->header_size + sizeof(uint16_t)) {
+		return -EBADMSG;
+	}
+
+	size = sys_get_le16(&iter->data[iter->header_size]);
+	if (iter->size - iter->header_size - sizeof(uint16_t) < size) {
+		return -EBADMSG;
+	}
+
+	*header = iter->data;
+	*msg = &iter->data[iter->header_size + sizeof(uint16_t)];
+	*msg_size = size;
+
+	iter->data += iter->header_size + sizeof(uint16_t) + size;
+	iter->size -= iter->header_size + sizeof(uint16_t) + size;
+	return 0;
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_FRAME_H_
+#define ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_FRAME_H_
+
+#include <zephyr/kernel.h>
+
+/* Sequence numbers of datagrams received from the host */
+struct zvb_bus_zvb_seq {
+	/* Next expected sequence number */
+	uint16_t next;
+	bool synced;
+};
+
+/*
+ * Check sequence number of received datagram, sync being set if the host
+ * restarted its sequence. Returns the number of datagrams lost before it, or
+ * -EALREADY if it is late or duplicate, and must be dropped.
+ */
+int zvb_bus_zvb_seq_check(struct zvb_bus_zvb_seq *seq, bool sync, uint16_t value);
+
+/* Iterator over the [header][size (le16)][data] messages of a batch */
+struct zvb_bus_zvb_batch_iter {
+	const uint8_t *data;
+	size_t size;
+	size_t header_size;
+};
+
+/* Start iterating over batch, without its batch address, with headers of header_size */
+void zvb_bus_zvb_batch_iter_init(struct zvb_bus_zvb_batch_iter *iter,
+				 const uint8_t *data,
+				 size_t size,
+				 size_t header_size);
+
+/*
+ * Get next message of batch. Returns 0 if successful, -ENODATA at the end of
+ * the batch, or -EBADMSG if the batch is truncated.
+ */
+int zvb_bus_zvb_batch_next(struct zvb_bus_zvb_batch_iter *iter,
+			   const uint8_t **header,
+			   const uint8_t **msg,
+			   size_t *msg_size);
+
+#endif /* ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_FRAME_H_ */
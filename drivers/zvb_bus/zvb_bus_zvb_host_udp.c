@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "zvb_bus_zvb_transport.h"
+#include "zvb_bus_zvb_host_udp_adapt.h"
+
+LOG_MODULE_DECLARE(zvb_zvb_bus, CONFIG_ZVB_BUS_LOG_LEVEL);
+
+BUILD_ASSERT(ZVB_BUS_ZVB_TRANSPORT_IOV_MAX <= ZVB_BUS_ZVB_HOST_UDP_ADAPT_IOV_MAX,
+	     "ZVB_BUS_ZVB_TRANSMIT_IOV_MAX exceeds the host UDP adaptation layer limit");
+
+int zvb_bus_zvb_transport_open(struct zvb_bus_zvb_transport *transport,
+			       const struct zvb_bus_zvb_transport_config *config)
+{
+	transport->fd = zvb_bus_zvb_host_udp_adapt_open(config->host_addr, config->host_port);
+	if (transport->fd < 0) {
+		LOG_ERR("Failed to create socket");
+		return -EIO;
+	}
+
+	return 0;
+}
+
+int zvb_bus_zvb_transport_send(struct zvb_bus_zvb_transport *transport,
+			       const struct zvb_bus_iovec *iov,
+			       size_t iov_count)
+{
+	int ret;
+	struct zvb_bus_zvb_host_udp_adapt_iovec msg_iov[ZVB_BUS_ZVB_TRANSPORT_IOV_MAX];
+
+	for (size_t i = 0; i < iov_count; i++) {
+		msg_iov[i].data = iov[i].data;
+		msg_iov[i].size = iov[i].size;
+	}
+
+	ret = zvb_bus_zvb_host_udp_adapt_send(transport->fd, msg_iov, iov_count);
+	if (ret == ZVB_BUS_ZVB_HOST_UDP_ADAPT_AGAIN) {
+		return -ENOBUFS;
+	}
+
+	return ret < 0 ? -EIO : 0;
+}
+
+int zvb_bus_zvb_transport_wait_host(struct zvb_bus_zvb_transport *transport,
+				    int32_t timeout_us)
+{
+	int ret;
+
+	ret = zvb_bus_zvb_host_udp_adapt_wait(transport->fd, timeout_us);
+	if (ret == 0) {
+		return -EAGAIN;
+	}
+
+	return ret < 0 ? -EIO : 0;
+}
+
+int zvb_bus_zvb_transport_recv(struct zvb_bus_zvb_transport *transport,
+			       uint8_t *buf,
+			       size_t size)
+{
+	int ret;
+
+	ret = zvb_bus_zvb_host_udp_adapt_recv(transport->fd, buf, size);
+	if (ret == ZVB_BUS_ZVB_HOST_UDP_ADAPT_AGAIN) {
+		return -EAGAIN;
+	}
+
+	return ret < 0 ? -EIO : ret;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host side of the zvb bus host UDP socket transport. This file is built
+ * with the host libc, and is called directly from the embedded side.
+ */
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "zvb_bus_zvb_host_udp_adapt.h"
+
+int zvb_bus_zvb_host_udp_adapt_open(const char *addr, uint16_t port)
+{
+	int fd;
+	struct sockaddr_in sin = {
+		.sin_family = AF_INET,
+		.sin_port = htons(port),
+	};
+
+	if (inet_pton(AF_INET, addr, &sin.sin_addr) != 1) {
+		return ZVB_BUS_ZVB_HOST_UDP_ADAPT_ERR;
+	}
+
+	fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_UDP);
+	if (fd < 0) {
+		return ZVB_BUS_ZVB_HOST_UDP_ADAPT_ERR;
+	}
+
+	/* Only datagrams from the host simulator are received once connected */
+	if (connect(fd, (struct sockaddr *)&sin, sizeof(sin)) < 0) {
+		close(fd);
+		return ZVB_BUS_ZVB_HOST_UDP_ADAPT_ERR;
+	}
+
+	return fd;
+}
+
+int zvb_bus_zvb_host_udp_adapt_send(int fd,
+				    const struct zvb_bus_zvb_host_udp_adapt_iovec *iov,
+				    size_t iov_count)
+{
+	struct iovec msg_iov[ZVB_BUS_ZVB_HOST_UDP_ADAPT_IOV_MAX];
+	struct msghdr msg = {
+		.msg_iov = msg_iov,
+		.msg_iovlen = iov_count,
+	};
+	ssize_t size;
+	ssize_t ret;
+
+	if (iov_count > ZVB_BUS_ZVB_HOST_UDP_ADAPT_IOV_MAX) {
+		return ZVB_BUS_ZVB_HOST_UDP_ADAPT_ERR;
+	}
+
+	size = 0;
+	for (size_t i = 0; i < iov_count; i++) {
+		msg_iov[i].iov_base = (void *)iov[i].data;
+		msg_iov[i].iov_len = iov[i].size;
+		size += iov[i].size;
+	}
+
+	ret = sendmsg(fd, &msg, 0);
+	if ((ret < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+		return ZVB_BUS_ZVB_HOST_UDP_ADAPT_AGAIN;
+	}
+
+	/* Not listening yet, the datagram is lost like any other */
+	if ((ret < 0) && (errno == ECONNREFUSED)) {
+		return 0;
+	}
+
+	return ret == size ? 0 : ZVB_BUS_ZVB_HOST_UDP_ADAPT_ERR;
+}
+
+int zvb_bus_zvb_host_udp_adapt_wait(int fd, int32_t timeout_us)
+{
+	struct pollfd pollfd = {
+		.fd = fd,
+		.events = POLLIN,
+	};
+	/* Rounded up, so the host is never woken up before the timeout */
+	int timeout_ms = timeout_us < 0 ? -1 : (timeout_us + 999) / 1000;
+	int ret;
+
+	do {
+		ret = poll(&pollfd, 1, timeout_ms);
+	} while ((ret < 0) && (errno == EINTR));
+
+	return ret < 0 ? ZVB_BUS_ZVB_HOST_UDP_ADAPT_ERR : ret;
+}
+
+int zvb_bus_zvb_host_udp_adapt_recv(int fd, uint8_t *buf, size_t size)
+{
+	ssize_t ret;
+
+	ret = recv(fd, buf, size, MSG_DONTWAIT | MSG_TRUNC);
+	if (ret < 0) {
+		/* Pending ICMP errors from a host simulator which was not listening */
+		if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == ECONNREFUSED)) {
+			return ZVB_BUS_ZVB_HOST_UDP_ADAPT_AGAIN;
+		}
+
+		return ZVB_BUS_ZVB_HOST_UDP_ADAPT_ERR;
+	}
+
+	return ret;
+}
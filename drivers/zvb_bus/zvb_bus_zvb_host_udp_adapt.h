@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host UDP socket transport between the zvb bus driver and the host
+ * simulator. This header is included both by the embedded side of the
+ * driver and by the host side adaptation layer, so it must not depend on
+ * Zephyr headers.
+ */
+
+#ifndef ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_HOST_UDP_ADAPT_H_
+#define ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_HOST_UDP_ADAPT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ZVB_BUS_ZVB_HOST_UDP_ADAPT_ERR -1
+#define ZVB_BUS_ZVB_HOST_UDP_ADAPT_AGAIN -2
+
+/* Maximum number of buffers gathered into a single datagram */
+#define ZVB_BUS_ZVB_HOST_UDP_ADAPT_IOV_MAX 16
+
+struct zvb_bus_zvb_host_udp_adapt_iovec {
+	const void *data;
+	size_t size;
+};
+
+/*
+ * Create UDP socket connected to the IPv4 address addr and port, returns
+ * socket or ZVB_BUS_ZVB_HOST_UDP_ADAPT_ERR
+ */
+int zvb_bus_zvb_host_udp_adapt_open(const char *addr, uint16_t port);
+
+/* Send a single datagram gathered from iov */
+int zvb_bus_zvb_host_udp_adapt_send(int fd,
+				    const struct zvb_bus_zvb_host_udp_adapt_iovec *iov,
+				    size_t iov_count);
+
+/*
+ * Block the calling host thread until a datagram is pending, or for at most
+ * timeout_us unless it is negative. Returns 1 if a datagram is pending, 0 on
+ * timeout.
+ */
+int zvb_bus_zvb_host_udp_adapt_wait(int fd, int32_t timeout_us);
+
+/*
+ * Receive a single datagram without blocking, truncated to size, returns
+ * its full size or ZVB_BUS_ZVB_HOST_UDP_ADAPT_AGAIN
+ */
+int zvb_bus_zvb_host_udp_adapt_recv(int fd, uint8_t *buf, size_t size);
+
+#endif /* ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_HOST_UDP_ADAPT_H_ */
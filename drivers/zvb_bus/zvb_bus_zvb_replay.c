@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+#include <string.h>
+
+#include "zvb_bus_zvb_capture.h"
+#include "zvb_bus_zvb_file_adapt.h"
+#include "zvb_bus_zvb_transport.h"
+
+LOG_MODULE_DECLARE(zvb_zvb_bus, CONFIG_ZVB_BUS_LOG_LEVEL);
+
+/*
+ * Read record headers until the next received datagram, leaving the file
+ * positioned at its data. Transmitted datagrams are skipped.
+ */
+static int transport_next(struct zvb_bus_zvb_transport *transport)
+{
+	uint8_t header[ZVB_BUS_ZVB_CAPTURE_RECORD_HEADER_SIZE];
+	int ret;
+
+	while (1) {
+		ret = zvb_bus_zvb_file_adapt_read(transport->fd, header, sizeof(header));
+		if (ret == 0) {
+			LOG_INF("Replay finished");
+			transport->pending = false;
+			return 0;
+		}
+
+		if (ret < 0) {
+			LOG_ERR("Got truncated capture record");
+			return -EIO;
+		}
+
+		transport->size = sys_get_le16(&header[sizeof(uint64_t) + sizeof(uint8_t)]);
+
+		if (header[sizeof(uint64_t)] == ZVB_BUS_ZVB_CAPTURE_RX) {
+			break;
+		}
+
+		if (zvb_bus_zvb_file_adapt_skip(transport->fd, transport->size) < 0) {
+			return -EIO;
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_ZVB_BUS_ZVB_REPLAY_TIMED)) {
+		transport->due_us = (int64_t)sys_get_le64(&header[0]);
+	} else {
+		transport->due_us = k_ticks_to_us_ceil64(k_uptime_ticks() + 1);
+	}
+
+	transport->pending = true;
+	return 0;
+}
+
+int zvb_bus_zvb_transport_open(struct zvb_bus_zvb_transport *transport,
+			       const struct zvb_bus_zvb_transport_config *config)
+{
+	uint8_t header[ZVB_BUS_ZVB_CAPTURE_HEADER_SIZE];
+
+	transport->fd = zvb_bus_zvb_file_adapt_open(config->path);
+	if (transport->fd < 0) {
+		LOG_ERR("Failed to open capture file %s", config->path);
+		return -EIO;
+	}
+
+	if ((zvb_bus_zvb_file_adapt_read(transport->fd, header, sizeof(header)) <= 0) ||
+	    memcmp(header, ZVB_BUS_ZVB_CAPTURE_MAGIC, ZVB_BUS_ZVB_CAPTURE_MAGIC_SIZE) ||
+	    (header[ZVB_BUS_ZVB_CAPTURE_MAGIC_SIZE] != ZVB_BUS_ZVB_CAPTURE_VERSION)) {
+		LOG_ERR("Invalid capture file %s", config->path);
+		return -EIO;
+	}
+
+	return transport_next(transport);
+}
+
+int zvb_bus_zvb_transport_send(struct zvb_bus_zvb_transport *transport,
+			       const struct zvb_bus_iovec *iov,
+			       size_t iov_count)
+{
+	ARG_UNUSED(transport);
+	ARG_UNUSED(iov);
+	ARG_UNUSED(iov_count);
+
+	/* There is no host to transmit to */
+	return 0;
+}
+
+int zvb_bus_zvb_transport_wait(struct zvb_bus_zvb_transport *transport)
+{
+	if (!transport->pending) {
+		k_sleep(K_FOREVER);
+	}
+
+	k_sleep(K_TIMEOUT_ABS_US(transport->due_us));
+	return 0;
+}
+
+int zvb_bus_zvb_transport_recv(struct zvb_bus_zvb_transport *transport,
+			       uint8_t *buf,
+			       size_t size)
+{
+	size_t record_size;
+	int ret;
+
+	if (!transport->pending ||
+	    (transport->due_us > k_ticks_to_us_floor64(k_uptime_ticks()))) {
+		return -EAGAIN;
+	}
+
+	record_size = transport->size;
+
+	/* Truncate records which do not fit, like a datagram socket would */
+	ret = zvb_bus_zvb_file_adapt_read(transport->fd, buf, MIN(record_size, size));
+	if ((ret >= 0) && (record_size > size)) {
+		ret = zvb_bus_zvb_file_adapt_skip(transport->fd, record_size - size);
+	}
+
+	if (ret < 0) {
+		LOG_ERR("Got truncated capture record");
+		return -EIO;
+	}
+
+	ret = transport_next(transport);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return record_size;
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/shell/shell.h>
+
+#include "zvb_bus_zvb_clock.h"
+#include "zvb_bus_zvb_stats.h"
+
+static bool device_is_zvb_bus(const struct device *dev)
+{
+	return DEVICE_API_IS(zvb_bus, dev) && (zvb_bus_zvb_stats_data_get(dev) != NULL);
+}
+
+#ifdef CONFIG_ZVB_BUS_ZVB_CLOCK_SYNC
+static void print_clock(const struct shell *sh, const struct device *dev)
+{
+	int64_t offset_ns;
+	int32_t drift_ppb;
+
+	if (!zvb_bus_zvb_clock_get(zvb_bus_zvb_clock_data_get(dev), &offset_ns, &drift_ppb)) {
+		return;
+	}
+
+	shell_print(sh, "  host clock offset: %lldns", (long long)offset_ns);
+	shell_print(sh, "  host clock drift: %dppb", drift_ppb);
+}
+#endif
+
+static void print_stats(const struct shell *sh, const struct device *dev)
+{
+	struct zvb_bus_zvb_stats stats;
+
+	zvb_bus_zvb_stats_get(zvb_bus_zvb_stats_data_get(dev), &stats);
+
+	shell_print(sh, "%s", dev->name);
+	shell_print(sh, "  rx wakeups: %u", stats.rx_wakeups);
+	shell_print(sh, "  rx datagrams: %u", stats.rx_datagrams);
+	shell_print(sh, "  rx datagrams per wakeup max: %u", stats.rx_burst_max);
+
+	if (IS_ENABLED(CONFIG_ZVB_BUS_ZVB_SEQ)) {
+		shell_print(sh, "  rx datagrams lost: %u", stats.rx_lost);
+		shell_print(sh, "  rx datagrams reordered: %u", stats.rx_reordered);
+	}
+
+	shell_print(sh, "  rx datagrams truncated: %u", stats.rx_truncated);
+
+	if (IS_ENABLED(CONFIG_ZVB_BUS_ZVB_BATCH)) {
+		shell_print(sh, "  tx batches failed: %u", stats.tx_batch_errors);
+	}
+
+#ifdef CONFIG_ZVB_BUS_ZVB_CLOCK_SYNC
+	print_clock(sh, dev);
+#endif
+
+	shell_print(sh, "  rtt samples: %u", stats.rtt_count);
+
+	if (stats.rtt_count == 0) {
+		return;
+	}
+
+	shell_print(sh, "  rtt min: %uns", stats.rtt_min_ns);
+	shell_print(sh, "  rtt p50: %uns", stats.rtt_p50_ns);
+	shell_print(sh, "  rtt p99: %uns", stats.rtt_p99_ns);
+	shell_print(sh, "  rtt max: %uns", stats.rtt_max_ns);
+}
+
+static int cmd_stats(const struct shell *sh, size_t argc, char **argv)
+{
+	const struct device *dev;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	for (size_t i = 0; (dev = shell_device_filter(i, device_is_zvb_bus)) != NULL; i++) {
+		print_stats(sh, dev);
+	}
+
+	return 0;
+}
+
+static int cmd_stats_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	const struct device *dev;
+
+	ARG_UNUSED(sh);
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	for (size_t i = 0; (dev = shell_device_filter(i, device_is_zvb_bus)) != NULL; i++) {
+		zvb_bus_zvb_stats_reset(zvb_bus_zvb_stats_data_get(dev));
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_ZVB_BUS_ZVB_STATS
+static int print_addr_stats_entry(struct stats_hdr *hdr,
+				  void *arg,
+				  const char *name,
+				  uint16_t off)
+{
+	const struct shell *sh = arg;
+
+	shell_print(sh, "    %s: %llu", name,
+		    (unsigned long long)*(uint64_t *)((uint8_t *)hdr + off));
+	return 0;
+}
+
+static void print_addr_stats(const struct shell *sh, const struct device *dev)
+{
+	struct zvb_bus_zvb_stats_data *stats = zvb_bus_zvb_stats_data_get(dev);
+	struct stats_hdr *hdr;
+
+	shell_print(sh, "%s", dev->name);
+
+	for (uint32_t addr = 0; addr <= UINT8_MAX; addr++) {
+		if (stats->addr[addr] == NULL) {
+			continue;
+		}
+
+		hdr = STATS_HDR(*stats->addr[addr]);
+		shell_print(sh, "  %s (addr: %u)", hdr->s_name, addr);
+		stats_walk(hdr, print_addr_stats_entry, (void *)sh);
+	}
+}
+
+static int cmd_addr_stats(const struct shell *sh, size_t argc, char **argv)
+{
+	const struct device *dev;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	for (size_t i = 0; (dev = shell_device_filter(i, device_is_zvb_bus)) != NULL; i++) {
+		print_addr_stats(sh, dev);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_ZVB_BUS_ZVB_STATS */
+
+#define STATS_HELP SHELL_HELP("Print statistics of each bus", "")
+
+#define ADDR_STATS_HELP SHELL_HELP("Print statistics of each device on each bus", "")
+
+#define STATS_RESET_HELP SHELL_HELP("Reset statistics of each bus", "")
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+	sub_zvb_bus_stats,
+	SHELL_CMD_ARG(
+		reset,
+		NULL,
+		STATS_RESET_HELP,
+		cmd_stats_reset,
+		1,
+		0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+	sub_zvb_bus,
+	SHELL_CMD_ARG(
+		stats,
+		&sub_zvb_bus_stats,
+		STATS_HELP,
+		cmd_stats,
+		1,
+		0),
+	SHELL_COND_CMD_ARG(
+		CONFIG_ZVB_BUS_ZVB_STATS,
+		addr_stats,
+		NULL,
+		ADDR_STATS_HELP,
+		cmd_addr_stats,
+		1,
+		0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(zvb_bus, &sub_zvb_bus, "ZVB bus commands", NULL);
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "zvb_bus_zvb_transport.h"
+#include "zvb_bus_zvb_shm_adapt.h"
+
+LOG_MODULE_DECLARE(zvb_zvb_bus, CONFIG_ZVB_BUS_LOG_LEVEL);
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_ZVB_BUS_ZVB_SHM_RING_SIZE),
+	     "Shared memory ring size must be a power of two");
+
+int zvb_bus_zvb_transport_open(struct zvb_bus_zvb_transport *transport,
+			       const struct zvb_bus_zvb_transport_config *config)
+{
+	transport->handle = zvb_bus_zvb_shm_adapt_open(config->name,
+						       CONFIG_ZVB_BUS_ZVB_SHM_RING_SIZE);
+	if (transport->handle < 0) {
+		LOG_ERR("Failed to open shared memory");
+		return -EIO;
+	}
+
+	return 0;
+}
+
+int zvb_bus_zvb_transport_send(struct zvb_bus_zvb_transport *transport,
+			       const struct zvb_bus_iovec *iov,
+			       size_t iov_count)
+{
+	int ret;
+	struct zvb_bus_zvb_shm_adapt_iovec msg_iov[ZVB_BUS_ZVB_TRANSPORT_IOV_MAX];
+	k_spinlock_key_t key;
+
+	for (size_t i = 0; i < iov_count; i++) {
+		msg_iov[i].data = iov[i].data;
+		msg_iov[i].size = iov[i].size;
+	}
+
+	key = k_spin_lock(&transport->tx_lock);
+	ret = zvb_bus_zvb_shm_adapt_send(transport->handle, msg_iov, iov_count);
+	k_spin_unlock(&transport->tx_lock, key);
+	if (ret == ZVB_BUS_ZVB_SHM_ADAPT_FULL) {
+		return -ENOBUFS;
+	}
+
+	return ret < 0 ? -EIO : 0;
+}
+
+int zvb_bus_zvb_transport_wait_host(struct zvb_bus_zvb_transport *transport,
+				    int32_t timeout_us)
+{
+	int ret;
+
+	ret = zvb_bus_zvb_shm_adapt_wait(transport->handle, timeout_us);
+	if (ret == 0) {
+		return -EAGAIN;
+	}
+
+	return ret < 0 ? -EIO : 0;
+}
+
+int zvb_bus_zvb_transport_recv(struct zvb_bus_zvb_transport *transport,
+			       uint8_t *buf,
+			       size_t size)
+{
+	int ret;
+
+	ret = zvb_bus_zvb_shm_adapt_recv(transport->handle, buf, size);
+	if (ret == 0) {
+		/* Frames are never empty, the ring is */
+		return -EAGAIN;
+	}
+
+	return ret < 0 ? -EIO : ret;
+}
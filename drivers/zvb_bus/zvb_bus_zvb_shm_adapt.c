@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host side of the zvb bus shared memory transport. This file is built
+ * with the host libc, and is called directly from the embedded side.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "zvb_bus_zvb_shm_adapt.h"
+
+#define SHM_INSTANCES_MAX 4
+
+struct shm_instance {
+	struct zvb_bus_zvb_shm_header *header;
+	uint8_t *tx_data;
+	uint8_t *rx_data;
+	uint32_t mask;
+};
+
+static struct shm_instance instances[SHM_INSTANCES_MAX];
+static int instance_count;
+
+static void ring_write(uint8_t *data, uint32_t mask, uint32_t pos, const void *src, size_t size)
+{
+	uint32_t offset = pos & mask;
+	size_t first = mask + 1 - offset;
+
+	if (first > size) {
+		first = size;
+	}
+
+	memcpy(&data[offset], src, first);
+	memcpy(data, (const uint8_t *)src + first, size - first);
+}
+
+static void ring_read(const uint8_t *data, uint32_t mask, uint32_t pos, void *dst, size_t size)
+{
+	uint32_t offset = pos & mask;
+	size_t first = mask + 1 - offset;
+
+	if (first > size) {
+		first = size;
+	}
+
+	memcpy(dst, &data[offset], first);
+	memcpy((uint8_t *)dst + first, data, size - first);
+}
+
+int zvb_bus_zvb_shm_adapt_open(const char *name, uint32_t ring_size)
+{
+	char path[PATH_MAX];
+	size_t size;
+	int fd;
+	struct stat st;
+	void *mem;
+	struct shm_instance *instance;
+	struct zvb_bus_zvb_shm_header *header;
+
+	if (instance_count == SHM_INSTANCES_MAX) {
+		return ZVB_BUS_ZVB_SHM_ADAPT_ERR;
+	}
+
+	snprintf(path, sizeof(path), "/dev/shm/%s", name);
+	size = sizeof(struct zvb_bus_zvb_shm_header) + (2 * (size_t)ring_size);
+
+	fd = open(path, O_RDWR | O_CREAT, 0600);
+	if (fd < 0) {
+		return ZVB_BUS_ZVB_SHM_ADAPT_ERR;
+	}
+
+	if ((fstat(fd, &st) < 0) ||
+	    ((st.st_size < (off_t)size) && (ftruncate(fd, size) < 0))) {
+		close(fd);
+		return ZVB_BUS_ZVB_SHM_ADAPT_ERR;
+	}
+
+	mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (mem == MAP_FAILED) {
+		return ZVB_BUS_ZVB_SHM_ADAPT_ERR;
+	}
+
+	header = mem;
+	if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != ZVB_BUS_ZVB_SHM_MAGIC) {
+		memset(mem, 0, size);
+		header->version = ZVB_BUS_ZVB_SHM_VERSION;
+		header->ring_size = ring_size;
+		__atomic_store_n(&header->magic, ZVB_BUS_ZVB_SHM_MAGIC, __ATOMIC_RELEASE);
+	} else if ((header->version != ZVB_BUS_ZVB_SHM_VERSION) ||
+		   (header->ring_size != ring_size)) {
+		munmap(mem, size);
+		return ZVB_BUS_ZVB_SHM_ADAPT_ERR;
+	}
+
+	/*
+	 * Frames left in the rx ring were pushed to a previous run of the target,
+	 * so they are discarded by moving the tail, which only the consumer
+	 * writes, up to the head.
+	 */
+	__atomic_store_n(&header->rx.waiters, 0, __ATOMIC_SEQ_CST);
+	__atomic_store_n(&header->rx.tail, __atomic_load_n(&header->rx.head, __ATOMIC_ACQUIRE),
+			 __ATOMIC_RELEASE);
+
+	instance = &instances[instance_count];
+	instance->header = header;
+	instance->tx_data = (uint8_t *)(header + 1);
+	instance->rx_data = instance->tx_data + ring_size;
+	instance->mask = ring_size - 1;
+	return instance_count++;
+}
+
+int zvb_bus_zvb_shm_adapt_send(int handle,
+			       const struct zvb_bus_zvb_shm_adapt_iovec *iov,
+			       size_t iov_count)
+{
+	struct shm_instance *instance = &instances[handle];
+	struct zvb_bus_zvb_shm_ring *ring = &instance->header->tx;
+	uint32_t head;
+	uint32_t tail;
+	uint32_t size;
+
+	size = 0;
+	for (size_t i = 0; i < iov_count; i++) {
+		size += iov[i].size;
+	}
+
+	head = ring->head;
+	tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+	if ((instance->mask + 1 - (head - tail)) < (sizeof(size) + size)) {
+		return ZVB_BUS_ZVB_SHM_ADAPT_FULL;
+	}
+
+	ring_write(instance->tx_data, instance->mask, head, &size, sizeof(size));
+	head += sizeof(size);
+
+	for (size_t i = 0; i < iov_count; i++) {
+		ring_write(instance->tx_data, instance->mask, head, iov[i].data, iov[i].size);
+		head += iov[i].size;
+	}
+
+	__atomic_store_n(&ring->head, head, __ATOMIC_RELEASE);
+	__atomic_fetch_add(&ring->seq, 1, __ATOMIC_SEQ_CST);
+
+	if (__atomic_load_n(&ring->waiters, __ATOMIC_SEQ_CST)) {
+		syscall(SYS_futex, &ring->seq, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+	}
+
+	return 0;
+}
+
+int zvb_bus_zvb_shm_adapt_pending(int handle)
+{
+	struct zvb_bus_zvb_shm_ring *ring = &instances[handle].header->rx;
+
+	return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) != ring->tail;
+}
+
+int zvb_bus_zvb_shm_adapt_wait(int handle, int32_t timeout_us)
+{
+	struct zvb_bus_zvb_shm_ring *ring = &instances[handle].header->rx;
+	struct timespec timeout = {
+		.tv_sec = timeout_us / 1000000,
+		.tv_nsec = (timeout_us % 1000000) * 1000,
+	};
+	uint32_t seq;
+	int pending;
+	long ret;
+
+	__atomic_store_n(&ring->waiters, 1, __ATOMIC_SEQ_CST);
+
+	while (1) {
+		seq = __atomic_load_n(&ring->seq, __ATOMIC_SEQ_CST);
+		pending = zvb_bus_zvb_shm_adapt_pending(handle);
+		if (pending) {
+			break;
+		}
+
+		/* Returns immediately if the producer has incremented seq since */
+		ret = syscall(SYS_futex, &ring->seq, FUTEX_WAIT, seq,
+			      timeout_us < 0 ? NULL : &timeout, NULL, 0);
+		if ((ret < 0) && (errno == ETIMEDOUT)) {
+			break;
+		}
+	}
+
+	__atomic_store_n(&ring->waiters, 0, __ATOMIC_SEQ_CST);
+	return pending;
+}
+
+int zvb_bus_zvb_shm_adapt_recv(int handle, uint8_t *buf, size_t size)
+{
+	struct shm_instance *instance = &instances[handle];
+	struct zvb_bus_zvb_shm_ring *ring = &instance->header->rx;
+	uint32_t head;
+	uint32_t tail;
+	uint32_t frame_size;
+
+	tail = ring->tail;
+	head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+	if (head == tail) {
+		return 0;
+	}
+
+	ring_read(instance->rx_data, instance->mask, tail, &frame_size, sizeof(frame_size));
+	tail += sizeof(frame_size);
+
+	/* Truncate frames which do not fit, like a datagram socket would */
+	if (size > frame_size) {
+		size = frame_size;
+	}
+
+	ring_read(instance->rx_data, instance->mask, tail, buf, size);
+	tail += frame_size;
+
+	__atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+	return frame_size;
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Shared memory transport between the zvb bus driver and the host simulator.
+ *
+ * This header is included both by the embedded side of the driver and by
+ * the host side adaptation layer, so it must not depend on Zephyr headers.
+ *
+ * The shared memory object /dev/shm/<name> contains a header followed by
+ * two single producer, single consumer byte rings, the tx ring from the
+ * target to the host followed by the rx ring from the host to the target.
+ * Each ring contains frames made up of a native endian uint32_t size
+ * followed by the frame data, which uses the same [addr][data] format as
+ * the UDP transport.
+ *
+ * head and tail are free running byte counters, only written by the
+ * producer and consumer respectively. The object outlives both sides, so
+ * when opening it each side discards the frames left in the ring it
+ * consumes by setting its tail to the head. The producer increments seq after
+ * every frame, and issues a FUTEX_WAKE on seq if waiters is set, so the
+ * consumer can sleep on seq with FUTEX_WAIT instead of polling.
+ */
+
+#ifndef ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_SHM_ADAPT_H_
+#define ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_SHM_ADAPT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ZVB_BUS_ZVB_SHM_MAGIC 0x5A564253
+#define ZVB_BUS_ZVB_SHM_VERSION 1
+
+#define ZVB_BUS_ZVB_SHM_ADAPT_ERR -1
+#define ZVB_BUS_ZVB_SHM_ADAPT_FULL -2
+
+struct zvb_bus_zvb_shm_ring {
+	uint32_t head;
+	uint32_t tail;
+	uint32_t seq;
+	uint32_t waiters;
+};
+
+struct zvb_bus_zvb_shm_header {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t ring_size;
+	uint32_t reserved;
+	struct zvb_bus_zvb_shm_ring tx;
+	struct zvb_bus_zvb_shm_ring rx;
+};
+
+struct zvb_bus_zvb_shm_adapt_iovec {
+	const void *data;
+	size_t size;
+};
+
+/* Map shared memory object, returns handle or ZVB_BUS_ZVB_SHM_ADAPT_ERR */
+int zvb_bus_zvb_shm_adapt_open(const char *name, uint32_t ring_size);
+
+/* Push a frame gathered from iov to the tx ring */
+int zvb_bus_zvb_shm_adapt_send(int handle,
+			       const struct zvb_bus_zvb_shm_adapt_iovec *iov,
+			       size_t iov_count);
+
+/* Returns 1 if a frame is pending in the rx ring, 0 otherwise */
+int zvb_bus_zvb_shm_adapt_pending(int handle);
+
+/*
+ * Block the calling host thread until a frame is pending in the rx ring, or
+ * for at most timeout_us unless it is negative. Returns 1 if a frame is
+ * pending, 0 on timeout.
+ */
+int zvb_bus_zvb_shm_adapt_wait(int handle, int32_t timeout_us);
+
+/*
+ * Pop a frame from the rx ring, truncated to size, returns its full size,
+ * or 0 if none is pending
+ */
+int zvb_bus_zvb_shm_adapt_recv(int handle, uint8_t *buf, size_t size);
+
+#endif /* ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_SHM_ADAPT_H_ */
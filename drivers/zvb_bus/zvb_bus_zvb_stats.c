@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <string.h>
+
+#include "zvb_bus_zvb_stats.h"
+
+#define RTT_SUB_BUCKET_BITS ZVB_BUS_ZVB_STATS_RTT_SUB_BUCKET_BITS
+#define RTT_SUB_BUCKETS BIT(RTT_SUB_BUCKET_BITS)
+#define RTT_BUCKETS ZVB_BUS_ZVB_STATS_RTT_BUCKETS
+
+#ifdef CONFIG_ZVB_BUS_ZVB_STATS
+STATS_NAME_START(zvb_bus_zvb_addr)
+STATS_NAME(zvb_bus_zvb_addr, rx_packets)
+STATS_NAME(zvb_bus_zvb_addr, rx_bytes)
+STATS_NAME(zvb_bus_zvb_addr, rx_drops)
+STATS_NAME(zvb_bus_zvb_addr, rx_oversize)
+STATS_NAME(zvb_bus_zvb_addr, tx_packets)
+STATS_NAME(zvb_bus_zvb_addr, tx_bytes)
+STATS_NAME(zvb_bus_zvb_addr, tx_drops)
+STATS_NAME(zvb_bus_zvb_addr, tx_oversize)
+STATS_NAME(zvb_bus_zvb_addr, handler_cycles)
+STATS_NAME(zvb_bus_zvb_addr, handler_cycles_max)
+STATS_NAME_END(zvb_bus_zvb_addr);
+#endif /* CONFIG_ZVB_BUS_ZVB_STATS */
+
+static uint32_t rtt_bucket_index(uint32_t value)
+{
+	uint32_t exp;
+
+	if (value < RTT_SUB_BUCKETS) {
+		return value;
+	}
+
+	exp = 31 - __builtin_clz(value);
+	return ((exp - RTT_SUB_BUCKET_BITS + 1) << RTT_SUB_BUCKET_BITS) +
+	       ((value >> (exp - RTT_SUB_BUCKET_BITS)) & (RTT_SUB_BUCKETS - 1));
+}
+
+static uint32_t rtt_bucket_value(uint32_t index)
+{
+	uint32_t exp;
+	uint32_t sub;
+
+	if (index < RTT_SUB_BUCKETS) {
+		return index;
+	}
+
+	exp = (index >> RTT_SUB_BUCKET_BITS) + RTT_SUB_BUCKET_BITS - 1;
+	sub = index & (RTT_SUB_BUCKETS - 1);
+	return (RTT_SUB_BUCKETS + sub) << (exp - RTT_SUB_BUCKET_BITS);
+}
+
+static uint32_t rtt_percentile(struct zvb_bus_zvb_stats_data *stats, uint32_t percent)
+{
+	uint32_t rank;
+	uint32_t count;
+	uint32_t i;
+
+	rank = DIV_ROUND_UP((uint64_t)stats->counters.rtt_count * percent, 100);
+	count = 0;
+
+	for (i = 0; i < RTT_BUCKETS; i++) {
+		count += stats->counters.rtt_buckets[i];
+		if (count >= rank) {
+			break;
+		}
+	}
+
+	return CLAMP(rtt_bucket_value(i),
+		     stats->counters.rtt_min_ns,
+		     stats->counters.rtt_max_ns);
+}
+
+#ifdef CONFIG_ZVB_BUS_ZVB_STATS
+void zvb_bus_zvb_stats_init(struct zvb_bus_zvb_stats_data *stats,
+			    STATS_SECT_DECL(zvb_bus_zvb_addr) *groups,
+			    const uint8_t *addrs,
+			    const char *const *names,
+			    size_t count)
+{
+	stats->addr_groups = groups;
+	stats->addr_group_count = count;
+
+	for (size_t i = 0; i < count; i++) {
+		stats_init_and_reg(STATS_HDR(groups[i]),
+				   STATS_SIZE_INIT_PARMS(groups[i], STATS_SIZE_64),
+				   STATS_NAME_INIT_PARMS(zvb_bus_zvb_addr),
+				   names[i]);
+
+		stats->addr[addrs[i]] = &groups[i];
+	}
+}
+
+void zvb_bus_zvb_stats_record_handler(struct zvb_bus_zvb_stats_data *stats,
+				      uint8_t addr,
+				      uint32_t cycles)
+{
+	STATS_SECT_DECL(zvb_bus_zvb_addr) *group = stats->addr[addr];
+
+	if (group == NULL) {
+		return;
+	}
+
+	STATS_INCN(*group, handler_cycles, cycles);
+	group->handler_cycles_max = MAX(group->handler_cycles_max, cycles);
+}
+#endif /* CONFIG_ZVB_BUS_ZVB_STATS */
+
+void zvb_bus_zvb_stats_record_rx(struct zvb_bus_zvb_stats_data *stats, uint32_t datagrams)
+{
+	K_SPINLOCK(&stats->lock) {
+		stats->counters.rx_wakeups++;
+		stats->counters.rx_datagrams += datagrams;
+		stats->counters.rx_burst_max = MAX(stats->counters.rx_burst_max, datagrams);
+	}
+}
+
+void zvb_bus_zvb_stats_record_lost(struct zvb_bus_zvb_stats_data *stats, uint32_t datagrams)
+{
+	K_SPINLOCK(&stats->lock) {
+		stats->counters.rx_lost += datagrams;
+	}
+}
+
+void zvb_bus_zvb_stats_record_reordered(struct zvb_bus_zvb_stats_data *stats)
+{
+	K_SPINLOCK(&stats->lock) {
+		stats->counters.rx_reordered++;
+	}
+}
+
+void zvb_bus_zvb_stats_record_rx_truncated(struct zvb_bus_zvb_stats_data *stats)
+{
+	K_SPINLOCK(&stats->lock) {
+		stats->counters.rx_truncated++;
+	}
+}
+
+void zvb_bus_zvb_stats_record_tx_batch_error(struct zvb_bus_zvb_stats_data *stats)
+{
+	K_SPINLOCK(&stats->lock) {
+		stats->counters.tx_batch_errors++;
+	}
+}
+
+void zvb_bus_zvb_stats_record_rtt(struct zvb_bus_zvb_stats_data *stats, uint32_t rtt_ns)
+{
+	K_SPINLOCK(&stats->lock) {
+		if (stats->counters.rtt_count == 0) {
+			stats->counters.rtt_min_ns = rtt_ns;
+		}
+
+		stats->counters.rtt_count++;
+		stats->counters.rtt_min_ns = MIN(stats->counters.rtt_min_ns, rtt_ns);
+		stats->counters.rtt_max_ns = MAX(stats->counters.rtt_max_ns, rtt_ns);
+		stats->counters.rtt_buckets[rtt_bucket_index(rtt_ns)]++;
+	}
+}
+
+void zvb_bus_zvb_stats_get(struct zvb_bus_zvb_stats_data *stats, struct zvb_bus_zvb_stats *snapshot)
+{
+	memset(snapshot, 0, sizeof(*snapshot));
+
+	K_SPINLOCK(&stats->lock) {
+		snapshot->rx_wakeups = stats->counters.rx_wakeups;
+		snapshot->rx_datagrams = stats->counters.rx_datagrams;
+		snapshot->rx_burst_max = stats->counters.rx_burst_max;
+		snapshot->rx_lost = stats->counters.rx_lost;
+		snapshot->rx_reordered = stats->counters.rx_reordered;
+		snapshot->rx_truncated = stats->counters.rx_truncated;
+		snapshot->tx_batch_errors = stats->counters.tx_batch_errors;
+		snapshot->rtt_count = stats->counters.rtt_count;
+
+		if (stats->counters.rtt_count == 0) {
+			K_SPINLOCK_BREAK;
+		}
+
+		snapshot->rtt_min_ns = stats->counters.rtt_min_ns;
+		snapshot->rtt_p50_ns = rtt_percentile(stats, 50);
+		snapshot->rtt_p99_ns = rtt_percentile(stats, 99);
+		snapshot->rtt_max_ns = stats->counters.rtt_max_ns;
+	}
+}
+
+void zvb_bus_zvb_stats_reset(struct zvb_bus_zvb_stats_data *stats)
+{
+	K_SPINLOCK(&stats->lock) {
+		memset(&stats->counters, 0, sizeof(stats->counters));
+	}
+
+#ifdef CONFIG_ZVB_BUS_ZVB_STATS
+	for (size_t i = 0; i < stats->addr_group_count; i++) {
+		stats_reset(STATS_HDR(stats->addr_groups[i]));
+	}
+#endif
+}
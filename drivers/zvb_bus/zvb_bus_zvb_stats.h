@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_STATS_H_
+#define ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_STATS_H_
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#ifdef CONFIG_ZVB_BUS_ZVB_STATS
+#include <zephyr/stats/stats.h>
+#endif
+
+/*
+ * Round trip times are recorded in a log-linear histogram. Values below
+ * 2^ZVB_BUS_ZVB_STATS_RTT_SUB_BUCKET_BITS get a bucket each, while every
+ * power of two above is split into 2^ZVB_BUS_ZVB_STATS_RTT_SUB_BUCKET_BITS
+ * linear buckets.
+ */
+#define ZVB_BUS_ZVB_STATS_RTT_SUB_BUCKET_BITS 3
+#define ZVB_BUS_ZVB_STATS_RTT_BUCKETS \
+	((32 - ZVB_BUS_ZVB_STATS_RTT_SUB_BUCKET_BITS + 1) << ZVB_BUS_ZVB_STATS_RTT_SUB_BUCKET_BITS)
+
+#ifdef CONFIG_ZVB_BUS_ZVB_STATS
+/* Per device address statistics, registered for each child of the bus node */
+STATS_SECT_START(zvb_bus_zvb_addr)
+STATS_SECT_ENTRY64(rx_packets)
+STATS_SECT_ENTRY64(rx_bytes)
+STATS_SECT_ENTRY64(rx_drops)
+STATS_SECT_ENTRY64(rx_oversize)
+STATS_SECT_ENTRY64(tx_packets)
+STATS_SECT_ENTRY64(tx_bytes)
+STATS_SECT_ENTRY64(tx_drops)
+STATS_SECT_ENTRY64(tx_oversize)
+STATS_SECT_ENTRY64(handler_cycles)
+STATS_SECT_ENTRY64(handler_cycles_max)
+STATS_SECT_END;
+#endif
+
+struct zvb_bus_zvb_stats {
+	uint32_t rx_wakeups;
+	uint32_t rx_datagrams;
+	uint32_t rx_burst_max;
+	uint32_t rx_lost;
+	uint32_t rx_reordered;
+	uint32_t rx_truncated;
+	uint32_t tx_batch_errors;
+	uint32_t rtt_count;
+	uint32_t rtt_min_ns;
+	uint32_t rtt_p50_ns;
+	uint32_t rtt_p99_ns;
+	uint32_t rtt_max_ns;
+};
+
+/* Statistics of a bus instance */
+struct zvb_bus_zvb_stats_data {
+	struct k_spinlock lock;
+	struct {
+		uint32_t rx_wakeups;
+		uint32_t rx_datagrams;
+		uint32_t rx_burst_max;
+		uint32_t rx_lost;
+		uint32_t rx_reordered;
+		uint32_t rx_truncated;
+	uint32_t rx_truncated;
+		uint32_t tx_batch_errors;
+		uint32_t rtt_count;
+		uint32_t rtt_min_ns;
+		uint32_t rtt_max_ns;
+		uint32_t rtt_buckets[ZVB_BUS_ZVB_STATS_RTT_BUCKETS];
+	} counters;
+#ifdef CONFIG_ZVB_BUS_ZVB_STATS
+	/* Indexed by device address, NULL for addresses without a device */
+	STATS_SECT_DECL(zvb_bus_zvb_addr) *addr[UINT8_MAX + 1];
+	STATS_SECT_DECL(zvb_bus_zvb_addr) *addr_groups;
+	size_t addr_group_count;
+#endif
+};
+
+#ifdef CONFIG_ZVB_BUS_ZVB_STATS
+#define ZVB_BUS_ZVB_ADDR_STATS_INCN(_stats, _addr, _entry, _n)					\
+	do {											\
+		if ((_stats)->addr[_addr] != NULL) {						\
+			STATS_INCN(*(_stats)->addr[_addr], _entry, _n);				\
+		}										\
+	} while (0)
+
+/* Register per device address statistics groups */
+void zvb_bus_zvb_stats_init(struct zvb_bus_zvb_stats_data *stats,
+			    STATS_SECT_DECL(zvb_bus_zvb_addr) *groups,
+			    const uint8_t *addrs,
+			    const char *const *names,
+			    size_t count);
+
+/* Record execution time of receive handler */
+void zvb_bus_zvb_stats_record_handler(struct zvb_bus_zvb_stats_data *stats,
+				      uint8_t addr,
+				      uint32_t cycles);
+#else
+#define ZVB_BUS_ZVB_ADDR_STATS_INCN(_stats, _addr, _entry, _n)
+#endif
+
+#define ZVB_BUS_ZVB_ADDR_STATS_INC(_stats, _addr, _entry) \
+	ZVB_BUS_ZVB_ADDR_STATS_INCN(_stats, _addr, _entry, 1)
+
+/* Get statistics of bus device instance */
+struct zvb_bus_zvb_stats_data *zvb_bus_zvb_stats_data_get(const struct device *dev);
+
+/* Record number of datagrams received in a single receive thread wakeup */
+void zvb_bus_zvb_stats_record_rx(struct zvb_bus_zvb_stats_data *stats, uint32_t datagrams);
+
+/* Record number of datagrams lost before a received datagram */
+void zvb_bus_zvb_stats_record_lost(struct zvb_bus_zvb_stats_data *stats, uint32_t datagrams);
+
+/* Record late or duplicate datagram */
+void zvb_bus_zvb_stats_record_reordered(struct zvb_bus_zvb_stats_data *stats);
+
+/* Record datagram truncated to the receive buffer */
+void zvb_bus_zvb_stats_record_rx_truncated(struct zvb_bus_zvb_stats_data *stats);
+
+/* Record batched datagram which could not be sent */
+void zvb_bus_zvb_stats_record_tx_batch_error(struct zvb_bus_zvb_stats_data *stats);
+
+/* Record ping/pong round trip time */
+void zvb_bus_zvb_stats_record_rtt(struct zvb_bus_zvb_stats_data *stats, uint32_t rtt_ns);
+
+/* Get snapshot of statistics */
+void zvb_bus_zvb_stats_get(struct zvb_bus_zvb_stats_data *stats, struct zvb_bus_zvb_stats *snapshot);
+
+/* Reset statistics */
+void zvb_bus_zvb_stats_reset(struct zvb_bus_zvb_stats_data *stats);
+
+#endif /* ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_STATS_H_ */
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_TRANSPORT_H_
+#define ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_TRANSPORT_H_
+
+#include <zvb/drivers/zvb_bus.h>
+
+#if defined(CONFIG_ZVB_BUS_ZVB_TRANSPORT_UDP)
+#include <zephyr/net/socket.h>
+#elif defined(CONFIG_ZVB_BUS_ZVB_TRANSPORT_SHM)
+#include <zephyr/spinlock.h>
+#endif
+
+/*
+ * Sequence header, message address header, plus the buffers passed to
+ * zvb_bus_transmit_iov()
+ */
+#define ZVB_BUS_ZVB_TRANSPORT_IOV_MAX \
+	(IS_ENABLED(CONFIG_ZVB_BUS_ZVB_SEQ) + 1 + CONFIG_ZVB_BUS_ZVB_TRANSMIT_IOV_MAX)
+
+#if defined(CONFIG_ZVB_BUS_ZVB_TRANSPORT_UDP)
+struct zvb_bus_zvb_transport_config {
+	const char *host_addr;
+	uint16_t host_port;
+};
+
+struct zvb_bus_zvb_transport {
+	int fd;
+	struct sockaddr_in addr;
+};
+#elif defined(CONFIG_ZVB_BUS_ZVB_TRANSPORT_HOST_UDP)
+struct zvb_bus_zvb_transport_config {
+	const char *host_addr;
+	uint16_t host_port;
+};
+
+struct zvb_bus_zvb_transport {
+	int fd;
+};
+#elif defined(CONFIG_ZVB_BUS_ZVB_TRANSPORT_SHM)
+struct zvb_bus_zvb_transport_config {
+	const char *name;
+};
+
+struct zvb_bus_zvb_transport {
+	int handle;
+	/* The tx ring has a single producer, but the bus transmits from many threads */
+	struct k_spinlock tx_lock;
+};
+#elif defined(CONFIG_ZVB_BUS_ZVB_TRANSPORT_UNIX)
+struct zvb_bus_zvb_transport_config {
+	const char *socket_path;
+};
+
+struct zvb_bus_zvb_transport {
+	int fd;
+	/* Reconnected to once the host closes the connection */
+	const char *socket_path;
+};
+#elif defined(CONFIG_ZVB_BUS_ZVB_TRANSPORT_REPLAY)
+struct zvb_bus_zvb_transport_config {
+	const char *path;
+};
+
+struct zvb_bus_zvb_transport {
+	int fd;
+	/* Next received datagram in capture file, and the uptime it is due at */
+	bool pending;
+	uint16_t size;
+	int64_t due_us;
+};
+#endif
+
+/* Open transport to host, called from the bus receive thread */
+int zvb_bus_zvb_transport_open(struct zvb_bus_zvb_transport *transport,
+			       const struct zvb_bus_zvb_transport_config *config);
+
+/* Send the buffers in iov to the host as a single datagram */
+int zvb_bus_zvb_transport_send(struct zvb_bus_zvb_transport *transport,
+			       const struct zvb_bus_iovec *iov,
+			       size_t iov_count);
+
+/*
+ * Wait until a datagram from the host can be received. Not implemented by
+ * transports which select ZVB_BUS_ZVB_HOST_WAIT.
+ */
+int zvb_bus_zvb_transport_wait(struct zvb_bus_zvb_transport *transport);
+
+/*
+ * Block the host, and thereby simulated time, until a datagram from the
+ * host can be received, or for at most timeout_us of real time unless it
+ * is SYS_FOREVER_US. Returns -EAGAIN on timeout. Only implemented by
+ * transports which exchange messages directly with the host.
+ */
+int zvb_bus_zvb_transport_wait_host(struct zvb_bus_zvb_transport *transport,
+				    int32_t timeout_us);
+
+/*
+ * Receive a single datagram from the host without blocking, returns its
+ * size, or -EAGAIN if no datagram is pending. Datagrams larger than size
+ * are truncated, while their full size is still returned.
+ */
+int zvb_bus_zvb_transport_recv(struct zvb_bus_zvb_transport *transport,
+			       uint8_t *buf,
+			       size_t size);
+
+#endif /* ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_TRANSPORT_H_ */
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/net/socket.h>
+#include <zephyr/logging/log.h>
+
+#include "zvb_bus_zvb_transport.h"
+
+LOG_MODULE_DECLARE(zvb_zvb_bus, CONFIG_ZVB_BUS_LOG_LEVEL);
+
+int zvb_bus_zvb_transport_open(struct zvb_bus_zvb_transport *transport,
+			       const struct zvb_bus_zvb_transport_config *config)
+{
+	transport->fd = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (transport->fd < 0) {
+		LOG_ERR("Failed to create socket");
+		return -EIO;
+	}
+
+	transport->addr.sin_family = AF_INET;
+	net_addr_pton(AF_INET, config->host_addr, &transport->addr.sin_addr);
+	transport->addr.sin_port = htons(config->host_port);
+	return 0;
+}
+
+int zvb_bus_zvb_transport_send(struct zvb_bus_zvb_transport *transport,
+			       const struct zvb_bus_iovec *iov,
+			       size_t iov_count)
+{
+	int ret;
+	size_t size;
+	struct iovec msg_iov[ZVB_BUS_ZVB_TRANSPORT_IOV_MAX];
+	struct msghdr msg = {
+		.msg_name = &transport->addr,
+		.msg_namelen = sizeof(transport->addr),
+		.msg_iov = msg_iov,
+		.msg_iovlen = iov_count,
+	};
+
+	size = 0;
+	for (size_t i = 0; i < iov_count; i++) {
+		msg_iov[i].iov_base = (void *)iov[i].data;
+		msg_iov[i].iov_len = iov[i].size;
+		size += iov[i].size;
+	}
+
+	ret = zsock_sendmsg(transport->fd, &msg, 0);
+
+	return ret == size ? 0 : -EIO;
+}
+
+int zvb_bus_zvb_transport_wait(struct zvb_bus_zvb_transport *transport)
+{
+	struct zsock_pollfd pollfd = {
+		.fd = transport->fd,
+		.events = ZSOCK_POLLIN,
+	};
+
+	return zsock_poll(&pollfd, 1, -1) < 0 ? -EIO : 0;
+}
+
+int zvb_bus_zvb_transport_recv(struct zvb_bus_zvb_transport *transport,
+			       uint8_t *buf,
+			       size_t size)
+{
+	int ret;
+
+	ret = zsock_recv(transport->fd, buf, size, ZSOCK_MSG_DONTWAIT | ZSOCK_MSG_TRUNC);
+	if (ret < 0) {
+		return errno == EAGAIN ? -EAGAIN : -EIO;
+	}
+
+	return ret;
+}
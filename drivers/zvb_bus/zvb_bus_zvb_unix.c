@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "zvb_bus_zvb_transport.h"
+#include "zvb_bus_zvb_unix_adapt.h"
+
+LOG_MODULE_DECLARE(zvb_zvb_bus, CONFIG_ZVB_BUS_LOG_LEVEL);
+
+BUILD_ASSERT(ZVB_BUS_ZVB_TRANSPORT_IOV_MAX <= ZVB_BUS_ZVB_UNIX_ADAPT_IOV_MAX,
+	     "ZVB_BUS_ZVB_TRANSMIT_IOV_MAX exceeds the unix adaptation layer limit");
+
+#define TRANSPORT_CONNECT_RETRY_MS 1000
+
+static void transport_connect(struct zvb_bus_zvb_transport *transport)
+{
+	while (1) {
+		transport->fd = zvb_bus_zvb_unix_adapt_open(transport->socket_path);
+		if (transport->fd >= 0) {
+			return;
+		}
+
+		LOG_WRN("Failed to connect to %s, retrying", transport->socket_path);
+		k_msleep(TRANSPORT_CONNECT_RETRY_MS);
+	}
+}
+
+int zvb_bus_zvb_transport_open(struct zvb_bus_zvb_transport *transport,
+			       const struct zvb_bus_zvb_transport_config *config)
+{
+	transport->socket_path = config->socket_path;
+	transport_connect(transport);
+	return 0;
+}
+
+int zvb_bus_zvb_transport_send(struct zvb_bus_zvb_transport *transport,
+			       const struct zvb_bus_iovec *iov,
+			       size_t iov_count)
+{
+	int ret;
+	struct zvb_bus_zvb_unix_adapt_iovec msg_iov[ZVB_BUS_ZVB_TRANSPORT_IOV_MAX];
+
+	for (size_t i = 0; i < iov_count; i++) {
+		msg_iov[i].data = iov[i].data;
+		msg_iov[i].size = iov[i].size;
+	}
+
+	ret = zvb_bus_zvb_unix_adapt_send(transport->fd, msg_iov, iov_count);
+	if (ret == ZVB_BUS_ZVB_UNIX_ADAPT_AGAIN) {
+		return -ENOBUFS;
+	}
+
+	return ret < 0 ? -EIO : 0;
+}
+
+int zvb_bus_zvb_transport_wait_host(struct zvb_bus_zvb_transport *transport,
+				    int32_t timeout_us)
+{
+	int ret;
+
+	ret = zvb_bus_zvb_unix_adapt_wait(transport->fd, timeout_us);
+	if (ret == 0) {
+		return -EAGAIN;
+	}
+
+	return ret < 0 ? -EIO : 0;
+}
+
+int zvb_bus_zvb_transport_recv(struct zvb_bus_zvb_transport *transport,
+			       uint8_t *buf,
+			       size_t size)
+{
+	int ret;
+
+	ret = zvb_bus_zvb_unix_adapt_recv(transport->fd, buf, size);
+	if (ret == ZVB_BUS_ZVB_UNIX_ADAPT_AGAIN) {
+		return -EAGAIN;
+	}
+
+	/* Transmissions fail until connected to the restarted host again */
+	if (ret == ZVB_BUS_ZVB_UNIX_ADAPT_CLOSED) {
+		LOG_WRN("Host closed %s, reconnecting", transport->socket_path);
+		zvb_bus_zvb_unix_adapt_close(transport->fd);
+		transport->fd = -1;
+		transport_connect(transport);
+		return -EAGAIN;
+	}
+
+	return ret < 0 ? -EIO : ret;
+}
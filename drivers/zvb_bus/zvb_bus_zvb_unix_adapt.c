@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host side of the zvb bus unix domain socket transport. This file is
+ * built with the host libc, and is called directly from the embedded side.
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "zvb_bus_zvb_unix_adapt.h"
+
+int zvb_bus_zvb_unix_adapt_open(const char *path)
+{
+	int fd;
+	struct sockaddr_un addr = {
+		.sun_family = AF_UNIX,
+	};
+
+	if (strlen(path) >= sizeof(addr.sun_path)) {
+		return ZVB_BUS_ZVB_UNIX_ADAPT_ERR;
+	}
+
+	strcpy(addr.sun_path, path);
+
+	fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (fd < 0) {
+		return ZVB_BUS_ZVB_UNIX_ADAPT_ERR;
+	}
+
+	if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		close(fd);
+		return ZVB_BUS_ZVB_UNIX_ADAPT_ERR;
+	}
+
+	return fd;
+}
+
+void zvb_bus_zvb_unix_adapt_close(int fd)
+{
+	close(fd);
+}
+
+int zvb_bus_zvb_unix_adapt_send(int fd,
+				const struct zvb_bus_zvb_unix_adapt_iovec *iov,
+				size_t iov_count)
+{
+	struct iovec msg_iov[ZVB_BUS_ZVB_UNIX_ADAPT_IOV_MAX];
+	struct msghdr msg = {
+		.msg_iov = msg_iov,
+		.msg_iovlen = iov_count,
+	};
+	ssize_t size;
+	ssize_t ret;
+
+	if (iov_count > ZVB_BUS_ZVB_UNIX_ADAPT_IOV_MAX) {
+		return ZVB_BUS_ZVB_UNIX_ADAPT_ERR;
+	}
+
+	size = 0;
+	for (size_t i = 0; i < iov_count; i++) {
+		msg_iov[i].iov_base = (void *)iov[i].data;
+		msg_iov[i].iov_len = iov[i].size;
+		size += iov[i].size;
+	}
+
+	ret = sendmsg(fd, &msg, MSG_NOSIGNAL);
+	if ((ret < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+		return ZVB_BUS_ZVB_UNIX_ADAPT_AGAIN;
+	}
+
+	return ret == size ? 0 : ZVB_BUS_ZVB_UNIX_ADAPT_ERR;
+}
+
+int zvb_bus_zvb_unix_adapt_wait(int fd, int32_t timeout_us)
+{
+	struct pollfd pollfd = {
+		.fd = fd,
+		.events = POLLIN,
+	};
+	/* Rounded up, so the host is never woken up before the timeout */
+	int timeout_ms = timeout_us < 0 ? -1 : (timeout_us + 999) / 1000;
+	int ret;
+
+	do {
+		ret = poll(&pollfd, 1, timeout_ms);
+	} while ((ret < 0) && (errno == EINTR));
+
+	return ret < 0 ? ZVB_BUS_ZVB_UNIX_ADAPT_ERR : ret;
+}
+
+int zvb_bus_zvb_unix_adapt_recv(int fd, uint8_t *buf, size_t size)
+{
+	ssize_t ret;
+
+	ret = recv(fd, buf, size, MSG_DONTWAIT | MSG_TRUNC);
+	if (ret < 0) {
+		if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+			return ZVB_BUS_ZVB_UNIX_ADAPT_AGAIN;
+		}
+
+		return ZVB_BUS_ZVB_UNIX_ADAPT_ERR;
+	}
+
+	/* Peer closed the connection */
+	if (ret == 0) {
+		return ZVB_BUS_ZVB_UNIX_ADAPT_CLOSED;
+	}
+
+	return ret;
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Unix domain socket transport between the zvb bus driver and the host
+ * simulator. This header is included both by the embedded side of the
+ * driver and by the host side adaptation layer, so it must not depend on
+ * Zephyr headers.
+ */
+
+#ifndef ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_UNIX_ADAPT_H_
+#define ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_UNIX_ADAPT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ZVB_BUS_ZVB_UNIX_ADAPT_ERR -1
+#define ZVB_BUS_ZVB_UNIX_ADAPT_AGAIN -2
+#define ZVB_BUS_ZVB_UNIX_ADAPT_CLOSED -3
+
+/* Maximum number of buffers gathered into a single packet */
+#define ZVB_BUS_ZVB_UNIX_ADAPT_IOV_MAX 16
+
+struct zvb_bus_zvb_unix_adapt_iovec {
+	const void *data;
+	size_t size;
+};
+
+/* Connect SOCK_SEQPACKET socket to path, returns socket or ZVB_BUS_ZVB_UNIX_ADAPT_ERR */
+int zvb_bus_zvb_unix_adapt_open(const char *path);
+
+/* Close socket returned by zvb_bus_zvb_unix_adapt_open() */
+void zvb_bus_zvb_unix_adapt_close(int fd);
+
+/* Send a single packet gathered from iov */
+int zvb_bus_zvb_unix_adapt_send(int fd,
+				const struct zvb_bus_zvb_unix_adapt_iovec *iov,
+				size_t iov_count);
+
+/*
+ * Block the calling host thread until a packet is pending, or for at most
+ * timeout_us unless it is negative. Returns 1 if a packet is pending, 0 on
+ * timeout.
+ */
+int zvb_bus_zvb_unix_adapt_wait(int fd, int32_t timeout_us);
+
+/*
+ * Receive a single packet without blocking, truncated to size, returns its
+ * full size,
+ * ZVB_BUS_ZVB_UNIX_ADAPT_AGAIN, or ZVB_BUS_ZVB_UNIX_ADAPT_CLOSED if the peer
+ * closed the connection
+ */
+int zvb_bus_zvb_unix_adapt_recv(int fd, uint8_t *buf, size_t size);
+
+#endif /* ZEPHYR_DRIVERS_ZVB_BUS_ZVB_BUS_ZVB_UNIX_ADAPT_H_ */
@@ -11,6 +11,10 @@
 #include <zephyr/sys/util.h>
 #include <errno.h>
 
+#ifdef CONFIG_ZVB_BUS_RTIO
+#include <zephyr/rtio/rtio.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -18,12 +22,19 @@ extern "C" {
 /** @cond INTERNAL_HIDDEN */
 
 struct zvb_bus_receive_callback;
+struct zvb_bus_iovec;
+struct net_buf;
+struct rtio_iodev_sqe;
 
 typedef void (*zvb_bus_receive_handler_t)(const struct device *dev,
 					  const struct zvb_bus_receive_callback *callback,
 					  const uint8_t *data,
 					  size_t size);
 
+typedef void (*zvb_bus_loss_handler_t)(const struct device *dev,
+				       const struct zvb_bus_receive_callback *callback,
+				       uint32_t count);
+
 typedef int (*zvb_bus_api_add_receive_callback)(const struct device *dev,
 						struct zvb_bus_receive_callback *callback);
 
@@ -35,10 +46,41 @@ typedef int (*zvb_bus_api_transmit)(const struct device *dev,
 				    const uint8_t *data,
 				    size_t size);
 
+typedef int (*zvb_bus_api_transmit_iov)(const struct device *dev,
+					uint8_t addr,
+					const struct zvb_bus_iovec *iov,
+					size_t iov_count);
+
+typedef int (*zvb_bus_api_flush)(const struct device *dev);
+
+typedef void (*zvb_bus_transmit_callback_t)(const struct device *dev,
+					    int result,
+					    void *user_data);
+
+typedef int (*zvb_bus_api_transmit_async)(const struct device *dev,
+					  uint8_t addr,
+					  const uint8_t *data,
+					  size_t size,
+					  zvb_bus_transmit_callback_t callback,
+					  void *user_data);
+
+typedef int (*zvb_bus_api_receive_buf_ref)(const struct device *dev,
+					   const uint8_t *data,
+					   struct net_buf **buf);
+
+typedef void (*zvb_bus_api_iodev_submit)(const struct device *dev,
+					 struct rtio_iodev_sqe *iodev_sqe);
+
+typedef int (*zvb_bus_api_host_time_to_uptime)(const struct device *dev,
+					       uint64_t host_time_us,
+					       int64_t *uptime_ns);
+
 struct zvb_bus_receive_callback {
 	sys_snode_t node;
 	uint8_t addr;
+	uint8_t dispatch;
 	zvb_bus_receive_handler_t handler;
+	zvb_bus_loss_handler_t loss_handler;
 };
 
 struct zvb_bus_dt_spec {
@@ -50,10 +92,91 @@ __subsystem struct zvb_bus_driver_api {
 	zvb_bus_api_add_receive_callback add_receive_callback;
 	zvb_bus_api_remove_receive_callback remove_receive_callback;
 	zvb_bus_api_transmit transmit;
+	zvb_bus_api_transmit_iov transmit_iov;
+	zvb_bus_api_flush flush;
+	zvb_bus_api_transmit_async transmit_async;
+	zvb_bus_api_receive_buf_ref receive_buf_ref;
+	zvb_bus_api_iodev_submit iodev_submit;
+	zvb_bus_api_host_time_to_uptime host_time_to_uptime;
 };
 
 /** @endcond */
 
+/** @brief ZVB bus receive handler dispatch class */
+enum zvb_bus_dispatch {
+	/**
+	 * Handler is called directly from the bus receive context. Used for
+	 * time critical handlers which must not block.
+	 */
+	ZVB_BUS_DISPATCH_INLINE = 0,
+	/**
+	 * Handler is called from a bus driver work queue with a copy of the
+	 * message, so it may block without delaying messages to other
+	 * devices.
+	 */
+	ZVB_BUS_DISPATCH_DEFERRED,
+};
+
+/**
+ * @brief Get ZVB bus device spec from devicetree node
+ *
+ * @param _node_id Devicetree node identifier of device on bus
+ *
+ * @returns initializer for struct zvb_bus_dt_spec
+ */
+#define ZVB_BUS_DT_SPEC_GET(_node_id) \
+	{.dev = DEVICE_DT_GET(DT_BUS(_node_id)), .addr = DT_REG_ADDR(_node_id)}
+
+/**
+ * @brief Get ZVB bus device spec from devicetree driver instance
+ *
+ * @param _inst Devicetree driver instance identifier
+ *
+ * @see ZVB_BUS_DT_SPEC_GET()
+ */
+#define ZVB_BUS_DT_SPEC_INST_GET(_inst) \
+	ZVB_BUS_DT_SPEC_GET(DT_DRV_INST(_inst))
+
+#if defined(CONFIG_ZVB_BUS_RTIO) || defined(__DOXYGEN__)
+
+/** @brief RTIO iodev API of devices on ZVB bus */
+extern const struct rtio_iodev_api zvb_bus_iodev_api;
+
+/**
+ * @brief Define RTIO iodev for device on ZVB bus from devicetree node
+ *
+ * @details The iodev accepts the following submissions:
+ *
+ * - RTIO_OP_TX and RTIO_OP_TINY_TX transmit the buffer to the device, as
+ *   with @ref zvb_bus_transmit().
+ * - RTIO_OP_RX completes with the next message received from the device,
+ *   with the size of the message as result. Messages complete pending reads
+ *   in submission order, and are passed to receive callbacks as well.
+ * - RTIO_OP_TXRX transmits the tx buffer, and completes with the reply from
+ *   the device in the rx buffer, like a write chained with a read, except
+ *   that the reply can't arrive before the read is queued.
+ *
+ * Reads fail with -ENOMEM if the message does not fit in the buffer, and
+ * with -EIO if the bus driver detects that messages from the host have been
+ * lost, since the awaited message may have been among them.
+ *
+ * @param _name Name of iodev
+ * @param _node_id Devicetree node identifier of device on bus
+ */
+#define ZVB_BUS_DT_IODEV_DEFINE(_name, _node_id)						\
+	const struct zvb_bus_dt_spec _zvb_bus_dt_spec_##_name = ZVB_BUS_DT_SPEC_GET(_node_id);	\
+	RTIO_IODEV_DEFINE(_name, &zvb_bus_iodev_api, (void *)&_zvb_bus_dt_spec_##_name)
+
+#endif /* defined(CONFIG_ZVB_BUS_RTIO) || defined(__DOXYGEN__) */
+
+/** @brief ZVB bus transmit buffer */
+struct zvb_bus_iovec {
+	/** Buffer data */
+	const uint8_t *data;
+	/** Size of buffer data in bytes */
+	size_t size;
+};
+
 /**
  * @brief Statically initialize ZVB bus receive callback from devicetree node
  *
@@ -78,6 +201,32 @@ __subsystem struct zvb_bus_driver_api {
 #define ZVB_BUS_DT_INST_RECEIVE_CALLBACK_INIT(_inst, _handler) \
 	{.addr = DT_REG_ADDR(DT_DRV_INST(_inst)), .handler = _handler}
 
+/**
+ * @brief Statically initialize ZVB bus receive callback with dispatch class
+ * from devicetree node
+ *
+ * @param _node_id Devicetree node identifier
+ * @param _handler Handler called when data is received from target device
+ * @param _dispatch Dispatch class of handler, see @ref zvb_bus_dispatch
+ *
+ * @see ZVB_BUS_DT_RECEIVE_CALLBACK_INIT()
+ */
+#define ZVB_BUS_DT_RECEIVE_CALLBACK_INIT_DISPATCH(_node_id, _handler, _dispatch) \
+	{.addr = DT_REG_ADDR(_node_id), .dispatch = _dispatch, .handler = _handler}
+
+/**
+ * @brief Statically initialize ZVB bus receive callback with dispatch class
+ * from devicetree driver instance
+ *
+ * @param _inst Devicetree driver instance identifier
+ * @param _handler Handler called when data is received from target device
+ * @param _dispatch Dispatch class of handler, see @ref zvb_bus_dispatch
+ *
+ * @see ZVB_BUS_DT_RECEIVE_CALLBACK_INIT_DISPATCH()
+ */
+#define ZVB_BUS_DT_INST_RECEIVE_CALLBACK_INIT_DISPATCH(_inst, _handler, _dispatch) \
+	ZVB_BUS_DT_RECEIVE_CALLBACK_INIT_DISPATCH(DT_DRV_INST(_inst), _handler, _dispatch)
+
 /**
  * @brief Initialize ZVB bus receive callback
  *
@@ -85,6 +234,9 @@ __subsystem struct zvb_bus_driver_api {
  * @param addr Address of target device to receive data from
  * @param handler Handler called when data is received from target device
  *
+ * @note The handler is dispatched inline, see
+ * @ref zvb_bus_receive_callback_set_dispatch()
+ *
  * @see callback must be initialized before being passed to this API
  *
  * @retval 0 if successful
@@ -95,7 +247,41 @@ static inline void zvb_bus_receive_callback_init(struct zvb_bus_receive_callback
 						 zvb_bus_receive_handler_t handler)
 {
 	callback->addr = addr;
+	callback->dispatch = ZVB_BUS_DISPATCH_INLINE;
 	callback->handler = handler;
+	callback->loss_handler = NULL;
+}
+
+/**
+ * @brief Set dispatch class of ZVB bus receive callback
+ *
+ * @param callback Initialized callback instance
+ * @param dispatch Dispatch class of handler
+ */
+static inline void zvb_bus_receive_callback_set_dispatch(struct zvb_bus_receive_callback *callback,
+							 enum zvb_bus_dispatch dispatch)
+{
+	callback->dispatch = dispatch;
+}
+
+/**
+ * @brief Set loss handler of ZVB bus receive callback
+ *
+ * @details The loss handler is called from the bus receive context with the
+ * number of lost datagrams when the bus driver detects that datagrams from the
+ * host have been lost, regardless of the dispatch class of the callback. Since
+ * any message may have been lost, drivers awaiting a reply may use this to
+ * resubmit their request without waiting for a timeout.
+ *
+ * @param callback Initialized callback instance
+ * @param loss_handler Handler called when datagrams from the host are lost, or
+ * NULL to not be notified
+ */
+static inline void
+zvb_bus_receive_callback_set_loss_handler(struct zvb_bus_receive_callback *callback,
+					  zvb_bus_loss_handler_t loss_handler)
+{
+	callback->loss_handler = loss_handler;
 }
 
 /**
@@ -104,12 +290,17 @@ static inline void zvb_bus_receive_callback_init(struct zvb_bus_receive_callback
  * @param dev ZVB Bus device instance
  * @param callback Callback to add
  *
- * @note callback must be initialized before being passed to this API
+ * @note callback must be initialized before being passed to this API, and must
+ * not be reinitialized while added.
+ *
+ * @note Adding a callback which is already added has no effect, so handlers may
+ * add callbacks, including their own, while being called.
  *
  * @see zvb_bus_receive_callback_init()
  * @see ZVB_BUS_RECEIVE_CALLBACK_INIT()
  *
  * @retval 0 if successful
+ * @retval -ENOTSUP if dispatch class of callback is not supported
  * @retval -errno code if failure
  */
 static inline int zvb_bus_add_receive_callback(const struct device *dev,
@@ -127,6 +318,9 @@ static inline int zvb_bus_add_receive_callback(const struct device *dev,
  * @note callback must have been added using @ref zvb_bus_add_receive_callback()
  * before being removed with this API.
  *
+ * @note Unless called from a deferred handler, the handler is not called once
+ * this API returns, including for messages already queued for deferred dispatch.
+ *
  * @retval 0 if successful
  * @retval -errno code if failure
  */
@@ -136,9 +330,44 @@ static inline int zvb_bus_remove_receive_callback(const struct device *dev,
 	return DEVICE_API_GET(zvb_bus, dev)->remove_receive_callback(dev, callback);
 }
 
+/**
+ * @brief Take reference to buffer holding received message
+ *
+ * @details May only be called from a receive handler, with the data passed
+ * to it. The message stays valid at data until the reference is released
+ * with net_buf_unref(), so drivers may keep it beyond the handler, or hand
+ * it off to another context, without copying it. The buffer may hold other
+ * messages of the same datagram, and must not be modified.
+ *
+ * @param dev ZVB Bus device instance
+ * @param data Message data passed to receive handler
+ * @param buf Destination for referenced buffer
+ *
+ * @retval 0 if successful
+ * @retval -ENOMEM if message is not held in a pooled buffer, in which case it
+ * must be copied
+ * @retval -ENOSYS if not supported by bus driver
+ */
+static inline int zvb_bus_receive_buf_ref(const struct device *dev,
+					  const uint8_t *data,
+					  struct net_buf **buf)
+{
+	const struct zvb_bus_driver_api *api = DEVICE_API_GET(zvb_bus, dev);
+
+	if (api->receive_buf_ref == NULL) {
+		return -ENOSYS;
+	}
+
+	return api->receive_buf_ref(dev, data, buf);
+}
+
 /**
  * @brief Transmit message to target device on bus
  *
+ * @details Bus drivers may queue the message and send it later, batched with
+ * other messages. Errors sending it are then not returned by this call, but
+ * counted in the statistics of the bus driver.
+ *
  * @param dev ZVB Bus device instance
  * @param addr Address of target device
  * @param data Message data
@@ -155,6 +384,122 @@ static inline int zvb_bus_transmit(const struct device *dev,
 	return DEVICE_API_GET(zvb_bus, dev)->transmit(dev, addr, data, size);
 }
 
+/**
+ * @brief Transmit message gathered from multiple buffers to target device on bus
+ *
+ * @details The buffers are concatenated into a single message, without the
+ * caller having to copy them into a contiguous buffer first.
+ *
+ * @param dev ZVB Bus device instance
+ * @param addr Address of target device
+ * @param iov Array of buffers which make up the message
+ * @param iov_count Number of buffers in iov
+ *
+ * @retval 0 if successful
+ * @retval -ENOSYS if not supported by bus driver
+ * @retval -errno code if failure
+ */
+static inline int zvb_bus_transmit_iov(const struct device *dev,
+				       uint8_t addr,
+				       const struct zvb_bus_iovec *iov,
+				       size_t iov_count)
+{
+	const struct zvb_bus_driver_api *api = DEVICE_API_GET(zvb_bus, dev);
+
+	if (api->transmit_iov == NULL) {
+		return -ENOSYS;
+	}
+
+	return api->transmit_iov(dev, addr, iov, iov_count);
+}
+
+/**
+ * @brief Queue message for transmission to target device on bus
+ *
+ * @details The message is copied to a transmit queue, and transmitted by the
+ * bus driver in the background, so this API returns without waiting for the
+ * transport. Messages queued with this API are transmitted in order, but may
+ * be reordered with respect to messages transmitted with
+ * @ref zvb_bus_transmit(). May be called from ISR.
+ *
+ * @param dev ZVB Bus device instance
+ * @param addr Address of target device
+ * @param data Message data
+ * @param size Size of message data in bytes
+ * @param callback Optional callback called with the result once transmitted
+ * @param user_data User data passed to callback
+ *
+ * @retval 0 if successful
+ * @retval -ENOBUFS if transmit queue is full
+ * @retval -ENOSYS if not supported by bus driver
+ * @retval -errno code if failure
+ */
+static inline int zvb_bus_transmit_async(const struct device *dev,
+					 uint8_t addr,
+					 const uint8_t *data,
+					 size_t size,
+					 zvb_bus_transmit_callback_t callback,
+					 void *user_data)
+{
+	const struct zvb_bus_driver_api *api = DEVICE_API_GET(zvb_bus, dev);
+
+	if (api->transmit_async == NULL) {
+		return -ENOSYS;
+	}
+
+	return api->transmit_async(dev, addr, data, size, callback, user_data);
+}
+
+/**
+ * @brief Map host time to system uptime
+ *
+ * @details Maps a timestamp taken by the host, like the time of a physics
+ * step a sensor reading was sampled at, to the corresponding system uptime,
+ * using the bus driver's estimate of the offset and drift of the host clock.
+ *
+ * @param dev ZVB Bus device instance
+ * @param host_time_us Host time in microseconds
+ * @param uptime_ns Destination for system uptime in nanoseconds
+ *
+ * @retval 0 if successful
+ * @retval -EAGAIN if host clock is not yet estimated
+ * @retval -ENOSYS if not supported by bus driver
+ */
+static inline int zvb_bus_host_time_to_uptime(const struct device *dev,
+					      uint64_t host_time_us,
+					      int64_t *uptime_ns)
+{
+	const struct zvb_bus_driver_api *api = DEVICE_API_GET(zvb_bus, dev);
+
+	if (api->host_time_to_uptime == NULL) {
+		return -ENOSYS;
+	}
+
+	return api->host_time_to_uptime(dev, host_time_us, uptime_ns);
+}
+
+/**
+ * @brief Flush messages queued for transmission
+ *
+ * @details Bus drivers may queue messages transmitted with @ref zvb_bus_transmit()
+ * and transmit them together. This API transmits any queued messages immediately.
+ *
+ * @param dev ZVB Bus device instance
+ *
+ * @retval 0 if successful
+ * @retval -errno code if failure
+ */
+static inline int zvb_bus_flush(const struct device *dev)
+{
+	const struct zvb_bus_driver_api *api = DEVICE_API_GET(zvb_bus, dev);
+
+	if (api->flush == NULL) {
+		return 0;
+	}
+
+	return api->flush(dev);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host side of the benchmark CPU time measurement. This file is built with
+ * the host libc, and is called directly from the embedded side.
+ */
+
+#include <time.h>
+
+#include "bench_adapt.h"
+
+uint64_t bench_adapt_cpu_time_ns(void)
+{
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts)) {
+		return 0;
+	}
+
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host CPU time of the native_sim process. This header is included both by
+ * the embedded side of the sample and by the host side adaptation layer, so
+ * it must not depend on Zephyr headers.
+ */
+
+#ifndef ZVB_BUS_BENCH_ADAPT_H_
+#define ZVB_BUS_BENCH_ADAPT_H_
+
+#include <stdint.h>
+
+/* CPU time consumed by the process in nanoseconds */
+uint64_t bench_adapt_cpu_time_ns(void);
+
+#endif /* ZVB_BUS_BENCH_ADAPT_H_ */
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Sweeps payload size, message rate and number of outstanding requests over
+ * the echo device, and prints the result of each run as a JSON object on a
+ * single line. Start the host simulator with the echo device first:
+ *
+ *     ./zvb_host.py --board zvb --device 0xf0:echo
+ *
+ * A run is aborted, and reported with timed_out set, once an echo does not
+ * arrive within BENCH_REPLY_TIMEOUT.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/printk.h>
+#include <zvb/drivers/zvb_bus.h>
+#include <stdlib.h>
+
+#ifdef CONFIG_NATIVE_LIBRARY
+#include "bench_adapt.h"
+#endif
+
+#define BENCH_NODE DT_NODELABEL(echo0)
+#define BENCH_MSG_COUNT 1000
+#define BENCH_REPLY_TIMEOUT K_MSEC(1000)
+
+/* Messages start with [run (le32)][transmit cycles (le32)] */
+#define BENCH_HEADER_SIZE (2 * sizeof(uint32_t))
+
+static const struct device *bus = DEVICE_DT_GET(DT_BUS(BENCH_NODE));
+static const uint8_t addr = DT_REG_ADDR(BENCH_NODE);
+
+static const uint16_t sizes[] = {8, 32, 128};
+/* Messages per second, 0 is unlimited */
+static const uint32_t rates[] = {100, 1000, 0};
+/* Maximum number of messages awaiting their echo */
+static const uint8_t depths[] = {1, 4, 16};
+
+static struct k_sem credits;
+static atomic_t run;
+static atomic_t received;
+static uint32_t rtt_ns[BENCH_MSG_COUNT];
+static uint8_t msg[128];
+
+static void receive_handler(const struct device *dev,
+			    const struct zvb_bus_receive_callback *cb,
+			    const uint8_t *data,
+			    size_t size)
+{
+	uint32_t cycles = k_cycle_get_32();
+	atomic_val_t index;
+
+	ARG_UNUSED(dev);
+	ARG_UNUSED(cb);
+
+	/* Echoes timed out in earlier runs must not be counted */
+	if (size < BENCH_HEADER_SIZE || sys_get_le32(data) != (uint32_t)atomic_get(&run)) {
+		return;
+	}
+
+	cycles -= sys_get_le32(&data[sizeof(uint32_t)]);
+	index = atomic_inc(&received);
+
+	if (index < BENCH_MSG_COUNT) {
+		rtt_ns[index] = (uint32_t)MIN(k_cyc_to_ns_floor64(cycles), UINT32_MAX);
+	}
+
+	k_sem_give(&credits);
+}
+
+static struct zvb_bus_receive_callback callback =
+	ZVB_BUS_DT_RECEIVE_CALLBACK_INIT(BENCH_NODE, receive_handler);
+
+static uint64_t bench_uptime_ns(void)
+{
+	return k_ticks_to_ns_floor64(k_uptime_ticks());
+}
+
+/* Simulated time stands still while native_sim runs code, so use the host CPU time */
+static uint64_t bench_cpu_time_ns(void)
+{
+#ifdef CONFIG_NATIVE_LIBRARY
+	return bench_adapt_cpu_time_ns();
+#else
+	k_thread_runtime_stats_t stats;
+
+	k_thread_runtime_stats_all_get(&stats);
+	return k_cyc_to_ns_floor64(stats.total_cycles);
+#endif
+}
+
+/*
+ * Batched messages are flushed before blocking, so their echoes can arrive.
+ * Returns -EAGAIN if no echo arrived in time.
+ */
+static int bench_take_credit(void)
+{
+	if (k_sem_take(&credits, K_NO_WAIT) == 0) {
+		return 0;
+	}
+
+	zvb_bus_flush(bus);
+	return k_sem_take(&credits, BENCH_REPLY_TIMEOUT);
+}
+
+static int bench_compare(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static uint32_t bench_percentile_us(uint32_t count, uint32_t percentile)
+{
+	if (count == 0) {
+		return 0;
+	}
+
+	return rtt_ns[((count - 1) * percentile) / 100] / NSEC_PER_USEC;
+}
+
+static void bench_report(uint16_t size,
+			 uint32_t rate,
+			 uint8_t depth,
+			 uint32_t sent,
+			 uint32_t count,
+			 uint64_t elapsed_ns,
+			 uint64_t cpu_ns,
+			 bool timed_out)
+{
+	uint64_t msgs_per_sec = elapsed_ns ? ((uint64_t)count * NSEC_PER_SEC) / elapsed_ns : 0;
+
+	qsort(rtt_ns, count, sizeof(rtt_ns[0]), bench_compare);
+
+	printk("{\"size\":%u,\"rate\":%u,\"depth\":%u,\"sent\":%u,\"received\":%u,"
+	       "\"elapsed_us\":%llu,\"msgs_per_sec\":%llu,\"bytes_per_sec\":%llu,"
+	       "\"rtt_p50_us\":%u,\"rtt_p90_us\":%u,\"rtt_p99_us\":%u,\"rtt_max_us\":%u,"
+	       "\"cpu_ns_per_msg\":%llu,\"timed_out\":%s}\n",
+	       size, rate, depth, sent, count,
+	       (unsigned long long)(elapsed_ns / NSEC_PER_USEC),
+	       (unsigned long long)msgs_per_sec,
+	       (unsigned long long)(msgs_per_sec * size),
+	       bench_percentile_us(count, 50),
+	       bench_percentile_us(count, 90),
+	       bench_percentile_us(count, 99),
+	       bench_percentile_us(count, 100),
+	       (unsigned long long)(sent ? cpu_ns / sent : 0),
+	       timed_out ? "true" : "false");
+}
+
+static void bench_run(uint16_t size, uint32_t rate, uint8_t depth)
+{
+	uint64_t start_ns;
+	uint64_t cpu_ns;
+	uint32_t sent = 0;
+	bool timed_out = false;
+	int ret;
+
+	atomic_inc(&run);
+	atomic_set(&received, 0);
+	k_sem_init(&credits, depth, depth);
+	sys_put_le32((uint32_t)atomic_get(&run), msg);
+
+	cpu_ns = bench_cpu_time_ns();
+	start_ns = bench_uptime_ns();
+
+	for (uint32_t i = 0; i < BENCH_MSG_COUNT; i++) {
+		if (rate) {
+			zvb_bus_flush(bus);
+			k_sleep(K_TIMEOUT_ABS_NS(start_ns + ((uint64_t)i * NSEC_PER_SEC) / rate));
+		}
+
+		/*
+		 * Sending without a credit would exceed the depth, and a late echo
+		 * would later return an extra credit, so abort the run instead
+		 */
+		if (bench_take_credit()) {
+			timed_out = true;
+			break;
+		}
+
+		sys_put_le32(k_cycle_get_32(), &msg[sizeof(uint32_t)]);
+
+		ret = zvb_bus_transmit(bus, addr, msg, size);
+		if (ret) {
+			printk("transmit failed: %d\n", ret);
+			break;
+		}
+
+		sent++;
+	}
+
+	/* Wait for the outstanding echoes */
+	zvb_bus_flush(bus);
+	for (uint8_t i = 0; (i < depth) && !timed_out; i++) {
+		if (k_sem_take(&credits, BENCH_REPLY_TIMEOUT)) {
+			timed_out = true;
+		}
+	}
+
+	bench_report(size,
+		     rate,
+		     depth,
+		     sent,
+		     MIN((uint32_t)atomic_get(&received), BENCH_MSG_COUNT),
+		     bench_uptime_ns() - start_ns,
+		     bench_cpu_time_ns() - cpu_ns,
+		     timed_out);
+}
+
+int main(void)
+{
+	int ret;
+
+	ret = zvb_bus_add_receive_callback(bus, &callback);
+	if (ret) {
+		printk("failed to add receive callback: %d\n", ret);
+		return 0;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+		for (size_t j = 0; j < ARRAY_SIZE(rates); j++) {
+			for (size_t k = 0; k < ARRAY_SIZE(depths); k++) {
+				bench_run(sizes[i], rates[j], depths[k]);
+			}
+		}
+	}
+
+	printk("{\"done\":true}\n");
+	return 0;
+}
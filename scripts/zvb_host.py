@@ -0,0 +1,686 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2025 Nordic Semiconductor ASA
+# SPDX-License-Identifier: Apache-2.0
+
+r"""This script is a headless stand-in for the Godot Engine ZVB project. It
+speaks the zvb_bus UDP protocol, implements the zvb,led, zvb,button,
+zvb,sensor and zvb,actuator devices, and drives the sensor readings from a
+simple plant model, so applications can run without the game engine, for
+example in CI.
+
+To run the blinky sample against the devices of the native_sim/native/zvb
+board, start the script before the application:
+
+    ./zvb_host.py --board zvb
+
+To run the mug_wheel sample against a simple model of the mug wheel:
+
+    ./zvb_host.py --board mug_wheel --plant mug_wheel
+
+Devices can be listed explicitly instead with the --device option, given
+as address:type, where type is one of led, button, sensor, actuator or
+echo:
+
+    ./zvb_host.py --device 0:led --device 4:button --device 8:sensor
+
+Echo devices reply to every message with the same message, for the
+zvb_bus_bench sample:
+
+    ./zvb_host.py --board zvb --device 0xf0:echo
+
+Buttons are toggled every --button-period seconds, if given. The script
+runs until interrupted, or for --duration seconds, and then prints the
+number of datagrams and bytes exchanged with the target. If the target is
+built with CONFIG_ZVB_BUS_ZVB_SEQ, the --seq option must be given.
+
+Pongs carry the host monotonic time, for CONFIG_ZVB_BUS_ZVB_CLOCK_SYNC. With
+--timestamps, sensor replies are prefixed with the host time the readings
+were sampled at, which the target maps to its own uptime.
+
+If the target is built with CONFIG_SENSOR_ZVB_SENSOR_DELTA, its sensor
+requests end with a flags byte and the generation of the last reply it
+decoded. Sensor replies then start with a flags byte, and are delta encoded
+against that reply. If it is built with CONFIG_SENSOR_ZVB_SENSOR_RETRY, the
+flagged requests also carry a request id, which the replies echo.
+
+If the target is built with CONFIG_ZVB_BUS_ZVB_PRIORITY, the --priority
+option must be given. Messages from the target are then handled, and
+messages to the target sent, in order of the priority of their device.
+
+Messages are exchanged as UDP datagrams by default, for both the UDP and
+host UDP transports. If the target is built with
+CONFIG_ZVB_BUS_ZVB_TRANSPORT_SHM, --transport shm must be given, along with
+--shm-name and --shm-ring-size if the target does not use the defaults. If
+it is built with CONFIG_ZVB_BUS_ZVB_TRANSPORT_UNIX, --transport unix must be
+given, along with --socket-path if the target does not use the default.
+
+If the target is built with CONFIG_ZVB_BUS_ZVB_LOCKSTEP, the --lockstep
+option must be given, with the simulated time to grant the target at a
+time in microseconds. The plant, buttons and --duration then follow the
+uptime of the target rather than the host clock. The mug_wheel sample
+enables lockstep with its overlay-lockstep.conf:
+
+    west build -b native_sim/native/mug_wheel samples/mug_wheel -- \
+        -DEXTRA_CONF_FILE=overlay-lockstep.conf
+    ./zvb_host.py --board mug_wheel --plant mug_wheel --lockstep 1000
+
+Batched datagrams from the target are split into their messages. The
+mug_wheel sample batches its messages, and enables the bus shell and
+statistics, with its overlay-batch.conf:
+
+    west build -b native_sim/native/mug_wheel samples/mug_wheel -- \
+        -DEXTRA_CONF_FILE=overlay-batch.conf
+"""
+
+import argparse
+import ctypes
+import math
+import mmap
+import os
+import platform
+import select
+import socket
+import struct
+import time
+
+PING_ADDRESS = 0xFF
+BATCH_ADDRESS = 0xFE
+TICK_ADDRESS = 0xFD
+
+SEQ_FLAG_SYNC = 0x01
+
+# Layout of the shared memory object, see zvb_bus_zvb_shm_adapt.h. Each ring
+# header is [head][tail][seq][waiters], the tx ring carries datagrams from
+# the target to the host, and the rx ring datagrams from the host to the
+# target.
+SHM_MAGIC = 0x5A564253
+SHM_VERSION = 1
+SHM_TX_RING = 16
+SHM_RX_RING = 32
+SHM_DATA = 48
+
+FUTEX_WAIT = 0
+FUTEX_WAKE = 1
+SYS_FUTEX = {'x86_64': 202, 'aarch64': 98}.get(platform.machine())
+
+# Sensor requests are 8 byte channel specs, optionally followed by a shorter
+# trailer of [flags][fields announced by the flags]
+SENSOR_REQUEST_SIZE = 8
+SENSOR_REQUEST_FLAG_DELTA = 0x01
+SENSOR_REQUEST_FLAG_ID = 0x02
+SENSOR_REPLY_FLAG_TIMESTAMP = 0x01
+SENSOR_REPLY_FLAG_DELTA = 0x02
+SENSOR_REPLY_FLAG_ID = 0x04
+
+# Values of enum sensor_channel
+SENSOR_CHAN_ACCEL_XYZ = 3
+SENSOR_CHAN_GYRO_XYZ = 7
+SENSOR_CHAN_ROTATION = 36
+
+GRAVITY = 9.80665
+
+class Plant():
+    # Plant without dynamics, at rest and upright
+
+    def actuate(self, addr: int, setpoint: float):
+        pass
+
+    def step(self, dt: float):
+        pass
+
+    def read(self, addr: int, chan_type: int, chan_idx: int) -> tuple[int, list[float]]:
+        if chan_type == SENSOR_CHAN_ACCEL_XYZ:
+            return 5, [0.0, GRAVITY, 0.0]
+        return 9, [0.0, 0.0, 0.0]
+
+class MugWheelPlant(Plant):
+    # Reaction wheel on a mug, with an arm which leans the mug sideways,
+    # using the addresses of the native_sim/native/mug_wheel board.
+
+    WHEEL_ENCODER = 0
+    ARM_ACTUATOR = 1
+    WHEEL_ACTUATOR = 2
+    IMU = 3
+
+    # Wheel angular acceleration at full setpoint in rad/s^2
+    WHEEL_TORQUE = 40.0
+    # Ratio of wheel to mug moment of inertia
+    INERTIA_RATIO = 0.1
+    # Lean rate at full arm setpoint in rad/s
+    ARM_RATE = 1.0
+    # Damping of rates in 1/s
+    DAMPING = 0.5
+
+    def __init__(self):
+        self.setpoints = {}
+        self.wheel_velocity = 0.0
+        self.yaw_rate = 0.0
+        self.lean = 0.0
+        self.lean_rate = 0.0
+
+    def actuate(self, addr: int, setpoint: float):
+        self.setpoints[addr] = setpoint
+
+    def step(self, dt: float):
+        wheel_acceleration = self.setpoints.get(self.WHEEL_ACTUATOR, 0.0) * self.WHEEL_TORQUE
+        wheel_acceleration -= self.wheel_velocity * self.DAMPING
+        self.wheel_velocity += wheel_acceleration * dt
+
+        # Angular momentum is conserved between wheel and mug
+        self.yaw_rate -= wheel_acceleration * self.INERTIA_RATIO * dt
+        self.yaw_rate -= self.yaw_rate * self.DAMPING * dt
+
+        self.lean_rate = self.setpoints.get(self.ARM_ACTUATOR, 0.0) * self.ARM_RATE
+        self.lean = max(-math.pi / 2, min(math.pi / 2, self.lean + self.lean_rate * dt))
+
+    def read(self, addr: int, chan_type: int, chan_idx: int) -> tuple[int, list[float]]:
+        if addr == self.WHEEL_ENCODER and chan_type == SENSOR_CHAN_ROTATION:
+            return 12, [math.degrees(self.wheel_velocity), 0.0, 0.0]
+
+        if addr == self.IMU and chan_type == SENSOR_CHAN_GYRO_XYZ:
+            return 4, [self.lean_rate, 0.0, self.yaw_rate]
+
+        if addr == self.IMU and chan_type == SENSOR_CHAN_ACCEL_XYZ:
+            return 5, [0.0, GRAVITY * math.cos(self.lean), GRAVITY * math.sin(self.lean)]
+
+        return super().read(addr, chan_type, chan_idx)
+
+PLANTS = {
+    'static': Plant,
+    'mug_wheel': MugWheelPlant,
+}
+
+# Devices of the boards in this repository, by address
+BOARDS = {
+    'zvb': {
+        0: 'led', 1: 'led', 2: 'led', 3: 'led',
+        4: 'button', 5: 'button', 6: 'button', 7: 'button',
+        8: 'sensor',
+    },
+    'mug_wheel': {
+        0: 'sensor', 1: 'actuator', 2: 'actuator', 3: 'sensor',
+    },
+}
+
+def to_q31(value: float, shift: int) -> int:
+    scaled = round(value * (1 << 31) / (1 << shift))
+    return max(-(1 << 31), min((1 << 31) - 1, scaled))
+
+def from_q31(value: int) -> float:
+    return value / (1 << 31)
+
+def zigzag_varint(value: int) -> bytes:
+    value = value - (1 << 32) if value & (1 << 31) else value
+    value = ((value << 1) ^ (value >> 31)) & 0xFFFFFFFF
+    encoded = b''
+    while value > 0x7F:
+        encoded += bytes([(value & 0x7F) | 0x80])
+        value >>= 7
+    return encoded + bytes([value])
+
+def host_time_us() -> bytes:
+    return struct.pack('<Q', time.monotonic_ns() // 1000)
+
+class UdpTransport():
+    def __init__(self, addr: str, port: int):
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.sock.bind((addr, port))
+        self.target = None
+
+    def send(self, datagram: bytes) -> bool:
+        if self.target is None:
+            return False
+
+        self.sock.sendto(datagram, self.target)
+        return True
+
+    def recv(self, timeout: float) -> bytes | None:
+        readable, _, _ = select.select([self.sock], [], [], timeout)
+        if not readable:
+            return None
+
+        datagram, self.target = self.sock.recvfrom(65536)
+        return datagram
+
+class Futex():
+    def __init__(self, mem: mmap.mmap, offset: int):
+        self.libc = ctypes.CDLL(None, use_errno=True)
+        self.word = ctypes.c_uint32.from_buffer(mem, offset)
+
+    def wait(self, value: int, timeout: float):
+        ts = struct.pack('@ll', int(timeout), int((timeout % 1) * 1e9))
+        self.libc.syscall(SYS_FUTEX, ctypes.byref(self.word), FUTEX_WAIT,
+                          ctypes.c_int(value), ts, None, 0)
+
+    def wake(self):
+        self.libc.syscall(SYS_FUTEX, ctypes.byref(self.word), FUTEX_WAKE,
+                          0x7FFFFFFF, None, None, 0)
+
+class ShmTransport():
+    def __init__(self, name: str, ring_size: int):
+        if SYS_FUTEX is None:
+            raise SystemExit(f'shm transport not supported on {platform.machine()}')
+
+        size = SHM_DATA + 2 * ring_size
+        fd = os.open(f'/dev/shm/{name}', os.O_RDWR | os.O_CREAT, 0o600)
+        if os.fstat(fd).st_size < size:
+            os.ftruncate(fd, size)
+        self.mem = mmap.mmap(fd, size)
+        os.close(fd)
+
+        magic, version, header_ring_size = struct.unpack_from('=III', self.mem, 0)
+        if magic != SHM_MAGIC:
+            self.mem[:] = bytes(size)
+            struct.pack_into('=II', self.mem, 4, SHM_VERSION, ring_size)
+            self._put(0, SHM_MAGIC)
+        elif version != SHM_VERSION or header_ring_size != ring_size:
+            raise SystemExit(f'/dev/shm/{name} has version {version}, ring size '
+                             f'{header_ring_size}')
+
+        # Datagrams left in the tx ring were pushed by a previous run of the
+        # target, the target likewise discards those left in the rx ring
+        self._put(SHM_TX_RING + 12, 0)
+        self._put(SHM_TX_RING + 4, self._get(SHM_TX_RING))
+
+        self.ring_size = ring_size
+        self.tx_seq = Futex(self.mem, SHM_TX_RING + 8)
+        self.rx_seq = Futex(self.mem, SHM_RX_RING + 8)
+
+    # Aligned 32 bit accesses, which are atomic and, on the supported
+    # architectures, ordered enough for a single producer and consumer
+    def _get(self, offset: int) -> int:
+        return struct.unpack_from('=I', self.mem, offset)[0]
+
+    def _put(self, offset: int, value: int):
+        struct.pack_into('=I', self.mem, offset, value & 0xFFFFFFFF)
+
+    def _ring_read(self, data: int, pos: int, size: int) -> bytes:
+        offset = pos & (self.ring_size - 1)
+        first = min(size, self.ring_size - offset)
+        return self.mem[data + offset:data + offset + first] + self.mem[data:data + size - first]
+
+    def _ring_write(self, data: int, pos: int, buf: bytes):
+        offset = pos & (self.ring_size - 1)
+        first = min(len(buf), self.ring_size - offset)
+        self.mem[data + offset:data + offset + first] = buf[:first]
+        self.mem[data:data + len(buf) - first] = buf[first:]
+
+    def send(self, datagram: bytes) -> bool:
+        head = self._get(SHM_RX_RING)
+        tail = self._get(SHM_RX_RING + 4)
+        frame = struct.pack('=I', len(datagram)) + datagram
+
+        # Dropped like a datagram to a full socket
+        if self.ring_size - ((head - tail) & 0xFFFFFFFF) < len(frame):
+            return False
+
+        self._ring_write(SHM_DATA + self.ring_size, head, frame)
+        self._put(SHM_RX_RING, head + len(frame))
+        self._put(SHM_RX_RING + 8, self._get(SHM_RX_RING + 8) + 1)
+
+        if self._get(SHM_RX_RING + 12):
+            self.rx_seq.wake()
+        return True
+
+    def recv(self, timeout: float) -> bytes | None:
+        tail = self._get(SHM_TX_RING + 4)
+
+        if self._get(SHM_TX_RING) == tail:
+            self._put(SHM_TX_RING + 12, 1)
+            seq = self._get(SHM_TX_RING + 8)
+            if self._get(SHM_TX_RING) == tail:
+                self.tx_seq.wait(seq, timeout)
+            self._put(SHM_TX_RING + 12, 0)
+
+            if self._get(SHM_TX_RING) == tail:
+                return None
+
+        size, = struct.unpack('=I', self._ring_read(SHM_DATA, tail, 4))
+        datagram = self._ring_read(SHM_DATA, tail + 4, size)
+        self._put(SHM_TX_RING + 4, tail + 4 + size)
+        return datagram
+
+class UnixTransport():
+    def __init__(self, path: str):
+        if os.path.exists(path):
+            os.unlink(path)
+
+        self.listener = socket.socket(socket.AF_UNIX, socket.SOCK_SEQPACKET)
+        self.listener.bind(path)
+        self.listener.listen(1)
+        self.conn = None
+
+    def _close(self):
+        self.conn.close()
+        self.conn = None
+
+    def send(self, datagram: bytes) -> bool:
+        if self.conn is None:
+            return False
+
+        try:
+            self.conn.send(datagram)
+        except OSError:
+            self._close()
+            return False
+        return True
+
+    def recv(self, timeout: float) -> bytes | None:
+        # The target connects once, and again whenever it is restarted
+        sock = self.listener if self.conn is None else self.conn
+        readable, _, _ = select.select([sock], [], [], timeout)
+        if not readable:
+            return None
+
+        if self.conn is None:
+            self.conn, _ = self.listener.accept()
+            return None
+
+        try:
+            datagram = self.conn.recv(65536)
+        except OSError:
+            datagram = b''
+
+        if not datagram:
+            self._close()
+            return None
+        return datagram
+
+class Host():
+    def __init__(self, transport, seq: bool, priority: bool):
+        self.transport = transport
+        self.seq = seq
+        self.tx_seq = 0
+        self.tx_synced = False
+        self.priority = priority
+        # Priority of each device, as carried by messages from the target
+        self.priorities = {}
+        self.tx_queue = []
+        self.stats = {
+            'rx_datagrams': 0,
+            'rx_bytes': 0,
+            'tx_datagrams': 0,
+            'tx_bytes': 0,
+        }
+
+    def send(self, addr: int, data: bytes):
+        self.tx_queue.append((addr, data))
+
+    def flush(self):
+        # Stable sort, so messages of equal priority are sent in order
+        queue = sorted(self.tx_queue, key=lambda msg: -self.priorities.get(msg[0], 0))
+        self.tx_queue = []
+
+        for addr, data in queue:
+            self._send(addr, data)
+
+    def _header(self, addr: int) -> bytes:
+        if self.priority:
+            return bytes([addr, self.priorities.get(addr, 0)])
+        return bytes([addr])
+
+    def _send(self, addr: int, data: bytes):
+        datagram = self._header(addr) + data
+        if self.seq:
+            flags = 0 if self.tx_synced else SEQ_FLAG_SYNC
+            datagram = struct.pack('<BH', flags, self.tx_seq) + datagram
+
+        if not self.transport.send(datagram):
+            return
+
+        if self.seq:
+            self.tx_seq = (self.tx_seq + 1) & 0xFFFF
+            self.tx_synced = True
+
+        self.stats['tx_datagrams'] += 1
+        self.stats['tx_bytes'] += len(datagram)
+
+    def recv(self, timeout: float) -> list[tuple[int, bytes]]:
+        datagram = self.transport.recv(timeout)
+        if datagram is None:
+            return []
+
+        self.stats['rx_datagrams'] += 1
+        self.stats['rx_bytes'] += len(datagram)
+
+        if self.seq:
+            datagram = datagram[3:]
+
+        if len(datagram) < 2:
+            return []
+
+        header_size = 2 if self.priority else 1
+
+        if datagram[0] != BATCH_ADDRESS:
+            msgs = [(datagram[:header_size], datagram[header_size:])]
+        else:
+            msgs = []
+            offset = 1
+            while offset + header_size + 2 <= len(datagram):
+                header = datagram[offset:offset + header_size]
+                size, = struct.unpack_from('<H', datagram, offset + header_size)
+                offset += header_size + 2
+                msgs.append((header, datagram[offset:offset + size]))
+                offset += size
+
+        if self.priority:
+            for header, _ in msgs:
+                self.priorities[header[0]] = header[1]
+            msgs.sort(key=lambda msg: -msg[0][1])
+
+        return [(header[0], data) for header, data in msgs]
+
+class Simulator():
+    def __init__(self, host: Host, plant: Plant, devices: dict[int, str],
+                 button_period: float, timestamps: bool, verbose: bool,
+                 lockstep_us: int | None):
+        self.host = host
+        self.plant = plant
+        self.devices = devices
+        self.button_period = button_period
+        self.timestamps = timestamps
+        self.verbose = verbose
+        self.lockstep_us = lockstep_us
+        # Uptime of the target at its last tick, in seconds
+        self.uptime = None
+        self.button_state = 0
+        # Last delta encoded reply to each sensor as (generation, frames)
+        self.sensor_deltas = {}
+
+    def _encode_sensor_delta(self, addr: int, ack: int, timestamp: bytes,
+                              frames: list[tuple[int, ...]]) -> bytes:
+        gen, base = self.sensor_deltas.get(addr, (0, []))
+        # Encode against zeroed frames unless the target decoded the last reply
+        base_gen = gen if ack != 0 and ack == gen else 0
+        if base_gen == 0:
+            base = []
+        gen = gen % 255 + 1
+        self.sensor_deltas[addr] = (gen, frames)
+
+        reply = bytes([gen, base_gen]) + timestamp
+        for i, frame in enumerate(frames):
+            prev = base[i] if i < len(base) else (0,) * len(frame)
+            mask = 0
+            deltas = b''
+            for j, (value, prev_value) in enumerate(zip(frame, prev)):
+                delta = (value - prev_value) & 0xFFFFFFFF
+                if delta:
+                    mask |= 1 << j
+                    deltas += zigzag_varint(delta)
+            reply += bytes([mask]) + deltas
+        return reply
+
+    def _handle_sensor(self, addr: int, data: bytes):
+        timestamp = host_time_us() if self.timestamps else b''
+        trailer = data[len(data) - len(data) % SENSOR_REQUEST_SIZE:]
+        frames = []
+        for offset in range(0, len(data) - len(trailer), SENSOR_REQUEST_SIZE):
+            chan_type, chan_idx = struct.unpack_from('<II', data, offset)
+            shift, readings = self.plant.read(addr, chan_type, chan_idx)
+            frames.append((chan_type, chan_idx, shift,
+                           *[to_q31(reading, shift) & 0xFFFFFFFF for reading in readings]))
+
+        whole = timestamp + b''.join(struct.pack('<IIIIII', *frame) for frame in frames)
+        if not trailer:
+            self.host.send(addr, whole)
+            return
+
+        request_flags, fields = trailer[0], trailer[1:]
+        flags = SENSOR_REPLY_FLAG_TIMESTAMP if timestamp else 0
+        ack = None
+        if request_flags & SENSOR_REQUEST_FLAG_DELTA and fields:
+            ack, fields = fields[0], fields[1:]
+
+        # The request id is echoed, so the target drops replies to resubmitted requests
+        echo = b''
+        if request_flags & SENSOR_REQUEST_FLAG_ID and fields:
+            flags |= SENSOR_REPLY_FLAG_ID
+            echo = fields[:1]
+
+        if ack is not None:
+            flags |= SENSOR_REPLY_FLAG_DELTA
+            body = self._encode_sensor_delta(addr, ack, timestamp, frames)
+        else:
+            body = whole
+        self.host.send(addr, bytes([flags]) + echo + body)
+
+    def _handle_tick(self, data: bytes):
+        uptime_us, = struct.unpack_from('<Q', data)
+        uptime = uptime_us / 1000000
+
+        # Grant the next step only after the replies to the messages before the tick
+        self.host.flush()
+        self.host.send(TICK_ADDRESS, struct.pack('<Q', uptime_us + self.lockstep_us))
+        self.host.flush()
+
+        self.uptime = uptime
+
+    def _handle_msg(self, addr: int, data: bytes):
+        if addr == TICK_ADDRESS and self.lockstep_us and len(data) >= 8:
+            self._handle_tick(data)
+            return
+
+        if addr == PING_ADDRESS:
+            self.host.send(PING_ADDRESS, data[:4] + host_time_us())
+            return
+
+        device = self.devices.get(addr)
+
+        if device == 'led' and len(data) == 1:
+            print(f'led@{addr:x}: {"on" if data[0] else "off"}')
+        elif device == 'actuator' and len(data) == 4:
+            setpoint = from_q31(struct.unpack('<i', data)[0])
+            self.plant.actuate(addr, setpoint)
+            if self.verbose:
+                print(f'actuator@{addr:x}: {setpoint:.6f}')
+        elif device == 'sensor':
+            self._handle_sensor(addr, data)
+        elif device == 'echo':
+            self.host.send(addr, data)
+        elif self.verbose:
+            print(f'unhandled message to {addr:x}: {data.hex()}')
+
+    def _toggle_buttons(self):
+        self.button_state ^= 1
+        for addr, device in self.devices.items():
+            if device == 'button':
+                self.host.send(addr, bytes([self.button_state]))
+
+    def _now(self) -> float:
+        if self.lockstep_us:
+            return self.uptime or 0.0
+        return time.monotonic()
+
+    def run(self, duration: float | None):
+        start = self._now()
+        last = start
+        next_toggle = start + self.button_period if self.button_period else None
+
+        while duration is None or last - start < duration:
+            for addr, data in self.host.recv(0.001):
+                self._handle_msg(addr, data)
+
+            now = self._now()
+            self.plant.step(now - last)
+            last = now
+
+            if next_toggle is not None and now >= next_toggle:
+                self._toggle_buttons()
+                next_toggle += self.button_period
+
+            self.host.flush()
+
+def parse_device(arg: str) -> tuple[int, str]:
+    addr, device = arg.split(':')
+    if device not in ['led', 'button', 'sensor', 'actuator', 'echo']:
+        raise argparse.ArgumentTypeError(f'unknown device type {device}')
+    return int(addr, 0), device
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        allow_abbrev=False
+    )
+    parser.add_argument("--transport", choices=['udp', 'shm', 'unix'], default='udp',
+                        help="transport the target is built with")
+    parser.add_argument("--shm-name", default="zvb_bus",
+                        help="shared memory object name, CONFIG_ZVB_BUS_ZVB_SHM_NAME")
+    parser.add_argument("--shm-ring-size", type=int, default=16384,
+                        help="shared memory ring size, CONFIG_ZVB_BUS_ZVB_SHM_RING_SIZE")
+    parser.add_argument("--socket-path", default="/tmp/zvb_bus.sock",
+                        help="unix domain socket path, socket-path of the bus node")
+    parser.add_argument("--addr", default="127.0.0.1",
+                        help="address to listen on, CONFIG_ZVB_BUS_ZVB_HOST_ADDR")
+    parser.add_argument("--port", type=int, default=5656,
+                        help="port to listen on, CONFIG_ZVB_BUS_ZVB_HOST_PORT")
+    parser.add_argument("--board", choices=BOARDS.keys(),
+                        help="simulate the devices of a board in this repository")
+    parser.add_argument("--device", type=parse_device, action='append', default=[],
+                        help="simulate device given as address:type")
+    parser.add_argument("--plant", choices=PLANTS.keys(), default='static',
+                        help="plant model driving the sensor readings")
+    parser.add_argument("--button-period", type=float,
+                        help="toggle buttons every button-period seconds")
+    parser.add_argument("--duration", type=float,
+                        help="stop after duration seconds")
+    parser.add_argument("--seq", action='store_true',
+                        help="use sequence headers, CONFIG_ZVB_BUS_ZVB_SEQ")
+    parser.add_argument("--priority", action='store_true',
+                        help="use message priorities, CONFIG_ZVB_BUS_ZVB_PRIORITY")
+    parser.add_argument("--timestamps", action='store_true',
+                        help="prefix sensor replies with the host time")
+    parser.add_argument("--lockstep", type=int, metavar='STEP_US',
+                        help="drive the simulated time of the target, for CONFIG_ZVB_BUS_ZVB_LOCKSTEP")
+    parser.add_argument("--verbose", action='store_true',
+                        help="print actuator setpoints and unhandled messages")
+    return parser.parse_args()
+
+def main():
+    args = parse_args()
+
+    devices = dict(BOARDS[args.board]) if args.board else {}
+    devices.update(args.device)
+
+    if args.transport == 'shm':
+        transport = ShmTransport(args.shm_name, args.shm_ring_size)
+    elif args.transport == 'unix':
+        transport = UnixTransport(args.socket_path)
+    else:
+        transport = UdpTransport(args.addr, args.port)
+
+    host = Host(transport, args.seq, args.priority)
+    simulator = Simulator(host, PLANTS[args.plant](), devices, args.button_period,
+                          args.timestamps, args.verbose, args.lockstep)
+
+    try:
+        simulator.run(args.duration)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        for name, value in host.stats.items():
+            print(f'{name}: {value}')
+
+if __name__=="__main__":
+    main()
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "sensor_zvb_sensor_delta.h"
+
+ZTEST_SUITE(zvb_sensor_delta, NULL, NULL, NULL, NULL, NULL);
+
+/* Decode encoded, which must hold a single varint, expecting value */
+static void test_varint(const uint8_t *encoded, size_t size, uint32_t expected)
+{
+	const uint8_t *data = encoded;
+	uint32_t value;
+
+	zassert_ok(sensor_zvb_sensor_delta_get_varint(&data, encoded + size, &value));
+	zassert_equal(value, expected, "got 0x%08x, expected 0x%08x", value, expected);
+	zassert_equal(data, encoded + size);
+}
+
+ZTEST(zvb_sensor_delta, test_varint_values)
+{
+	/* Encoded by zigzag_varint() of scripts/zvb_host.py */
+	test_varint((const uint8_t[]){0x00}, 1, 0);
+	test_varint((const uint8_t[]){0x01}, 1, (uint32_t)-1);
+	test_varint((const uint8_t[]){0x02}, 1, 1);
+	test_varint((const uint8_t[]){0x03}, 1, (uint32_t)-2);
+	test_varint((const uint8_t[]){0x7e}, 1, 63);
+	test_varint((const uint8_t[]){0x7f}, 1, (uint32_t)-64);
+	test_varint((const uint8_t[]){0x80, 0x01}, 2, 64);
+	test_varint((const uint8_t[]){0xfe, 0xff, 0xff, 0xff, 0x0f}, 5, INT32_MAX);
+	test_varint((const uint8_t[]){0xff, 0xff, 0xff, 0xff, 0x0f}, 5, (uint32_t)INT32_MIN);
+}
+
+ZTEST(zvb_sensor_delta, test_varint_truncated)
+{
+	static const uint8_t encoded[] = {0x80, 0x80};
+	const uint8_t *data = encoded;
+	uint32_t value;
+
+	zassert_equal(sensor_zvb_sensor_delta_get_varint(&data, data, &value), -EINVAL);
+	zassert_equal(sensor_zvb_sensor_delta_get_varint(&data, encoded + sizeof(encoded), &value),
+		      -EINVAL);
+}
+
+ZTEST(zvb_sensor_delta, test_varint_too_long)
+{
+	static const uint8_t encoded[] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x00};
+	const uint8_t *data = encoded;
+	uint32_t value;
+
+	zassert_equal(sensor_zvb_sensor_delta_get_varint(&data, encoded + sizeof(encoded), &value),
+		      -EINVAL);
+}
+
+ZTEST(zvb_sensor_delta, test_apply)
+{
+	static const uint8_t encoded[] = {
+		/* Frame 0: fields 0 and 5 */
+		0x21, 0x02, 0x01,
+		/* Frame 1: unchanged */
+		0x00,
+		/* Frame 2: field 1, wrapping */
+		0x02, 0x80, 0x01,
+		/* Padding */
+		0x00,
+	};
+	uint32_t fields[3][SENSOR_ZVB_SENSOR_DELTA_FIELD_COUNT] = {
+		{10, 20, 30, 40, 50, 60},
+		{1, 2, 3, 4, 5, 6},
+		{0, UINT32_MAX - 10, 0, 0, 0, 0},
+	};
+	const uint8_t *data = encoded;
+
+	zassert_ok(sensor_zvb_sensor_delta_apply(fields, ARRAY_SIZE(fields),
+						 &data, encoded + sizeof(encoded)));
+	zassert_equal(data, encoded + sizeof(encoded) - 1);
+
+	zassert_equal(fields[0][0], 11);
+	zassert_equal(fields[0][1], 20);
+	zassert_equal(fields[0][5], 59);
+	zassert_equal(fields[1][0], 1);
+	zassert_equal(fields[1][5], 6);
+	zassert_equal(fields[2][1], 53);
+}
+
+ZTEST(zvb_sensor_delta, test_apply_truncated)
+{
+	/* Second frame is missing */
+	static const uint8_t missing[] = {0x01, 0x02};
+	/* Mask announces two fields, but only one follows */
+	static const uint8_t short_frame[] = {0x03, 0x02};
+	uint32_t fields[2][SENSOR_ZVB_SENSOR_DELTA_FIELD_COUNT] = {0};
+	const uint8_t *data;
+
+	data = missing;
+	zassert_equal(sensor_zvb_sensor_delta_apply(fields, 2, &data, missing + sizeof(missing)),
+		      -EINVAL);
+
+	data = short_frame;
+	zassert_equal(sensor_zvb_sensor_delta_apply(fields, 1, &data,
+						    short_frame + sizeof(short_frame)),
+		      -EINVAL);
+}
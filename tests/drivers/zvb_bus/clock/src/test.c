@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <string.h>
+
+#include "zvb_bus_zvb_clock.h"
+
+#define TEST_RTT_NS (200 * NSEC_PER_USEC)
+#define TEST_PERIOD_NS (100 * NSEC_PER_MSEC)
+#define TEST_OFFSET_NS (5LL * NSEC_PER_SEC)
+
+static struct zvb_bus_zvb_clock test_clock;
+
+static void test_before(void *f)
+{
+	ARG_UNUSED(f);
+
+	memset(&test_clock, 0, sizeof(test_clock));
+}
+
+ZTEST_SUITE(zvb_bus_clock, NULL, NULL, test_before, NULL, NULL);
+
+/* Sample of a host clock ahead by offset_ns, running drift_ppb fast, stamped mid round trip */
+static void test_sample(int64_t t0_ns, uint32_t rtt_ns, int64_t offset_ns, int32_t drift_ppb)
+{
+	int64_t mid_ns = t0_ns + rtt_ns / 2;
+	int64_t host_ns = mid_ns + offset_ns + (mid_ns * drift_ppb) / (int64_t)NSEC_PER_SEC;
+
+	zvb_bus_zvb_clock_update(&test_clock, t0_ns, rtt_ns, host_ns);
+}
+
+ZTEST(zvb_bus_clock, test_not_synced)
+{
+	int64_t offset_ns;
+	int64_t uptime_ns;
+	int32_t drift_ppb;
+
+	zassert_false(zvb_bus_zvb_clock_get(&test_clock, &offset_ns, &drift_ppb));
+	zassert_equal(zvb_bus_zvb_clock_to_uptime(&test_clock, 0, &uptime_ns), -EAGAIN);
+}
+
+ZTEST(zvb_bus_clock, test_first_sample)
+{
+	int64_t offset_ns;
+	int64_t uptime_ns;
+	int32_t drift_ppb;
+
+	test_sample(NSEC_PER_SEC, TEST_RTT_NS, TEST_OFFSET_NS, 0);
+
+	zassert_true(zvb_bus_zvb_clock_get(&test_clock, &offset_ns, &drift_ppb));
+	zassert_equal(offset_ns, TEST_OFFSET_NS);
+	zassert_equal(drift_ppb, 0);
+
+	zassert_ok(zvb_bus_zvb_clock_to_uptime(&test_clock,
+					       TEST_OFFSET_NS + 3LL * NSEC_PER_SEC,
+					       &uptime_ns));
+	zassert_equal(uptime_ns, 3LL * NSEC_PER_SEC);
+}
+
+ZTEST(zvb_bus_clock, test_rtt_reject)
+{
+	int64_t offset_ns;
+	int32_t drift_ppb;
+
+	test_sample(NSEC_PER_SEC, TEST_RTT_NS, TEST_OFFSET_NS, 0);
+
+	/* Delayed in one direction only, so would move the offset by most of its round trip */
+	zvb_bus_zvb_clock_update(&test_clock,
+				 NSEC_PER_SEC + TEST_PERIOD_NS,
+				 10 * TEST_RTT_NS,
+				 NSEC_PER_SEC + TEST_PERIOD_NS + TEST_OFFSET_NS);
+
+	zassert_true(zvb_bus_zvb_clock_get(&test_clock, &offset_ns, &drift_ppb));
+	zassert_equal(offset_ns, TEST_OFFSET_NS);
+	zassert_equal(drift_ppb, 0);
+}
+
+ZTEST(zvb_bus_clock, test_step)
+{
+	int64_t offset_ns;
+	int32_t drift_ppb;
+	int64_t t0_ns = NSEC_PER_SEC;
+
+	for (int i = 0; i < 100; i++) {
+		test_sample(t0_ns, TEST_RTT_NS, TEST_OFFSET_NS, 100000);
+		t0_ns += TEST_PERIOD_NS;
+	}
+
+	zassert_true(zvb_bus_zvb_clock_get(&test_clock, &offset_ns, &drift_ppb));
+	zassert_not_equal(drift_ppb, 0);
+
+	/* Restarted host, the estimate starts over */
+	test_sample(t0_ns, TEST_RTT_NS, -TEST_OFFSET_NS, 0);
+
+	zassert_true(zvb_bus_zvb_clock_get(&test_clock, &offset_ns, &drift_ppb));
+	zassert_equal(offset_ns, -TEST_OFFSET_NS);
+	zassert_equal(drift_ppb, 0);
+}
+
+ZTEST(zvb_bus_clock, test_drift)
+{
+	const int32_t drift_ppb = 50000;
+	int64_t t0_ns = NSEC_PER_SEC;
+	int64_t offset_ns;
+	int64_t uptime_ns;
+	int64_t host_ns;
+	int32_t estimate_ppb;
+
+	for (int i = 0; i < 3000; i++) {
+		test_sample(t0_ns, TEST_RTT_NS, TEST_OFFSET_NS, drift_ppb);
+		t0_ns += TEST_PERIOD_NS;
+	}
+
+	zassert_true(zvb_bus_zvb_clock_get(&test_clock, &offset_ns, &estimate_ppb));
+	zassert_within(estimate_ppb, drift_ppb, drift_ppb / 100);
+
+	/* Host time of a moment one second past the last sample maps back to it */
+	uptime_ns = t0_ns + NSEC_PER_SEC;
+	host_ns = uptime_ns + TEST_OFFSET_NS + (uptime_ns * drift_ppb) / (int64_t)NSEC_PER_SEC;
+	zassert_ok(zvb_bus_zvb_clock_to_uptime(&test_clock, host_ns, &uptime_ns));
+	zassert_within(uptime_ns, t0_ns + NSEC_PER_SEC, 10 * NSEC_PER_USEC);
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <string.h>
+
+#include "zvb_bus_zvb_frame.h"
+
+#define TEST_HEADER_SIZE 1
+
+static struct zvb_bus_zvb_seq test_seq;
+
+static void test_before(void *f)
+{
+	ARG_UNUSED(f);
+
+	memset(&test_seq, 0, sizeof(test_seq));
+}
+
+ZTEST_SUITE(zvb_bus_frame, NULL, NULL, test_before, NULL, NULL);
+
+ZTEST(zvb_bus_frame, test_seq_in_order)
+{
+	/* The first datagram syncs, whatever its sequence number */
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, false, 1000), 0);
+
+	for (uint16_t seq = 1001; seq < 1100; seq++) {
+		zassert_equal(zvb_bus_zvb_seq_check(&test_seq, false, seq), 0);
+	}
+}
+
+ZTEST(zvb_bus_frame, test_seq_wrap)
+{
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, false, 0xfffe), 0);
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, false, 0xffff), 0);
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, false, 0x0000), 0);
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, false, 0x0001), 0);
+
+	/* Losses across the wrap */
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, true, 0xfffd), 0);
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, false, 0x0002), 4);
+
+	/* Late across the wrap */
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, false, 0xffff), -EALREADY);
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, false, 0x0003), 0);
+}
+
+ZTEST(zvb_bus_frame, test_seq_lost)
+{
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, false, 10), 0);
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, false, 13), 2);
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, false, 14), 0);
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, false, 20), 5);
+
+	/* Half the sequence space ahead is still a loss rather than late */
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, false, 20 + INT16_MAX + 1), INT16_MAX);
+}
+
+ZTEST(zvb_bus_frame, test_seq_late)
+{
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, false, 10), 0);
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, false, 12), 1);
+
+	/* Late and duplicate datagrams do not move the expected sequence number */
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, false, 11), -EALREADY);
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, false, 12), -EALREADY);
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, false, 13), 0);
+}
+
+ZTEST(zvb_bus_frame, test_seq_sync)
+{
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, false, 500), 0);
+
+	/* A restarted host is neither late nor a loss */
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, true, 0), 0);
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, false, 1), 0);
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, true, 9000), 0);
+	zassert_equal(zvb_bus_zvb_seq_check(&test_seq, false, 9001), 0);
+}
+
+ZTEST(zvb_bus_frame, test_batch_messages)
+{
+	static const uint8_t batch[] = {
+		0x10, 0x02, 0x00, 0xaa, 0xbb,
+		0x20, 0x00, 0x00,
+		0x30, 0x01, 0x00, 0xcc,
+	};
+	struct zvb_bus_zvb_batch_iter iter;
+	const uint8_t *header;
+	const uint8_t *msg;
+	size_t msg_size;
+
+	zvb_bus_zvb_batch_iter_init(&iter, batch, sizeof(batch), TEST_HEADER_SIZE);
+
+	zassert_ok(zvb_bus_zvb_batch_next(&iter, &header, &msg, &msg_size));
+	zassert_equal(header[0], 0x10);
+	zassert_equal(msg_size, 2);
+	zassert_equal(msg, &batch[3]);
+
+	/* Empty messages are returned, and left to the caller to drop */
+	zassert_ok(zvb_bus_zvb_batch_next(&iter, &header, &msg, &msg_size));
+	zassert_equal(header[0], 0x20);
+	zassert_equal(msg_size, 0);
+
+	zassert_ok(zvb_bus_zvb_batch_next(&iter, &header, &msg, &msg_size));
+	zassert_equal(header[0], 0x30);
+	zassert_equal(msg_size, 1);
+	zassert_equal(msg[0], 0xcc);
+
+	zassert_equal(zvb_bus_zvb_batch_next(&iter, &header, &msg, &msg_size), -ENODATA);
+	zassert_equal(zvb_bus_zvb_batch_next(&iter, &header, &msg, &msg_size), -ENODATA);
+}
+
+ZTEST(zvb_bus_frame, test_batch_header_size)
+{
+	/* Headers of two bytes */
+	static const uint8_t batch[] = {0x10, 0x03, 0x01, 0x00, 0xaa};
+	struct zvb_bus_zvb_batch_iter iter;
+	const uint8_t *header;
+	const uint8_t *msg;
+	size_t msg_size;
+
+	zvb_bus_zvb_batch_iter_init(&iter, batch, sizeof(batch), 2);
+
+	zassert_ok(zvb_bus_zvb_batch_next(&iter, &header, &msg, &msg_size));
+	zassert_equal(header[0], 0x10);
+	zassert_equal(header[1], 0x03);
+	zassert_equal(msg_size, 1);
+	zassert_equal(msg[0], 0xaa);
+	zassert_equal(zvb_bus_zvb_batch_next(&iter, &header, &msg, &msg_size), -ENODATA);
+}
+
+ZTEST(zvb_bus_frame, test_batch_empty)
+{
+	struct zvb_bus_zvb_batch_iter iter;
+	const uint8_t *header;
+	const uint8_t *msg;
+	size_t msg_size;
+
+	zvb_bus_zvb_batch_iter_init(&iter, NULL, 0, TEST_HEADER_SIZE);
+	zassert_equal(zvb_bus_zvb_batch_next(&iter, &header, &msg, &msg_size), -ENODATA);
+}
+
+ZTEST(zvb_bus_frame, test_batch_truncated_header)
+{
+	static const uint8_t batch[] = {0x10, 0x01, 0x00, 0xaa, 0x20, 0x01};
+	struct zvb_bus_zvb_batch_iter iter;
+	const uint8_t *header;
+	const uint8_t *msg;
+	size_t msg_size;
+
+	zvb_bus_zvb_batch_iter_init(&iter, batch, sizeof(batch), TEST_HEADER_SIZE);
+
+	zassert_ok(zvb_bus_zvb_batch_next(&iter, &header, &msg, &msg_size));
+	zassert_equal(zvb_bus_zvb_batch_next(&iter, &header, &msg, &msg_size), -EBADMSG);
+}
+
+ZTEST(zvb_bus_frame, test_batch_truncated_data)
+{
+	static const uint8_t batch[] = {0x10, 0x03, 0x00, 0xaa, 0xbb};
+	struct zvb_bus_zvb_batch_iter iter;
+	const uint8_t *header;
+	const uint8_t *msg;
+	size_t msg_size;
+
+	zvb_bus_zvb_batch_iter_init(&iter, batch, sizeof(batch), TEST_HEADER_SIZE);
+	zassert_equal(zvb_bus_zvb_batch_next(&iter, &header, &msg, &msg_size), -EBADMSG);
+}
+
+ZTEST(zvb_bus_frame, test_batch_size_overflow)
+{
+	/* Size which would wrap the remaining size if subtracted unchecked */
+	static const uint8_t batch[] = {0x10, 0xff, 0xff, 0xaa};
+	struct zvb_bus_zvb_batch_iter iter;
+	const uint8_t *header;
+	const uint8_t *msg;
+	size_t msg_size;
+
+	zvb_bus_zvb_batch_iter_init(&iter, batch, sizeof(batch), TEST_HEADER_SIZE);
+	zassert_equal(zvb_bus_zvb_batch_next(&iter, &header, &msg, &msg_size), -EBADMSG);
+}